@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#include <util/Sha256.h>
+#include "AssemblyCache.h"
+
+#ifndef VERSION
+#define VERSION "unknown"
+#endif
+
+namespace fs = std::filesystem;
+
+static const char* const ObjectFileName = "program.obj";
+// Holds the total size of the entries, and is locked while it is updated.
+static const char* const IndexFileName = "index";
+
+std::optional<AssemblyCache> AssemblyCache::open() {
+    if (const char* cacheHome = std::getenv("XDG_CACHE_HOME"); cacheHome && *cacheHome) {
+        return AssemblyCache{ fs::path{ cacheHome } / "lc3asm" };
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return AssemblyCache{ fs::path{ home } / ".cache" / "lc3asm" };
+    }
+    return std::nullopt;
+}
+
+std::string AssemblyCache::key(Util::StringView src, Util::StringView options) {
+    std::string header = "lc3asm " VERSION " ";
+
+    header += std::to_string(FormatVersion);
+    header += '\0';
+    header.append(options.data(), options.size());
+    header += '\0';
+
+    Util::Sha256 hasher;
+    hasher.update(header.data(), header.size());
+    hasher.update(src.data(), src.size());
+
+    return Util::Sha256::toHex(hasher.finish());
+}
+
+bool AssemblyCache::fetch(const std::string& key, const fs::path& outputPath) const {
+    fs::path objectPath = m_cacheDir / key / ObjectFileName;
+    std::error_code ec;
+
+    fs::copy_file(objectPath, outputPath, fs::copy_options::overwrite_existing, ec);
+
+    if (ec) {
+        return false;
+    }
+    // Eviction goes by when an entry was last written.
+    fs::last_write_time(objectPath, fs::file_time_type::clock::now(), ec);
+
+    return true;
+}
+
+void AssemblyCache::store(const std::string& key, const fs::path& outputPath) const {
+    static std::atomic<unsigned> nextTempId{ 0 };
+
+    // Fill in a directory of our own and rename it into place, so that a
+    // concurrent run never sees an entry that is only partly written.
+    fs::path entryDir = m_cacheDir / key;
+    fs::path tempDir = m_cacheDir / (key + ".tmp." + std::to_string(getpid()) + "." +
+                                     std::to_string(nextTempId++));
+    std::error_code ec;
+
+    if (fs::exists(entryDir, ec)) {
+        return;
+    }
+    fs::create_directories(tempDir, ec);
+
+    if (!ec) {
+        fs::copy_file(outputPath, tempDir / ObjectFileName, ec);
+    }
+    if (!ec) {
+        fs::rename(tempDir, entryDir, ec);
+    }
+    if (ec) {
+        fs::remove_all(tempDir, ec);
+
+        return;
+    }
+    uintmax_t entrySize = fs::file_size(entryDir / ObjectFileName, ec);
+
+    if (!ec) {
+        account(entrySize);
+    }
+}
+
+void AssemblyCache::account(uintmax_t addedSize) const {
+    int fd = ::open((m_cacheDir / IndexFileName).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+    if (fd < 0) {
+        return;
+    }
+    if (flock(fd, LOCK_EX) == 0) {
+        char text[32] = {};
+        uintmax_t totalSize = 0;
+
+        if (pread(fd, text, sizeof(text) - 1, 0) > 0) {
+            totalSize = std::strtoull(text, nullptr, 10);
+        }
+        totalSize += addedSize;
+
+        // Scanning the entries costs a few system calls each, so only do it
+        // once the total passes the limit, and then make room for many more
+        // stores before the next scan.
+        if (totalSize > m_maxSize) {
+            totalSize = evict(m_maxSize / 4 * 3);
+        }
+        std::string newText = std::to_string(totalSize);
+
+        // Starting the total over only puts off the next scan, which works
+        // out the size again from the entries themselves.
+        if (ftruncate(fd, 0) != 0 ||
+            pwrite(fd, newText.data(), newText.size(), 0) != ssize_t(newText.size()))
+        {
+            std::error_code ec;
+            fs::remove(m_cacheDir / IndexFileName, ec);
+        }
+    }
+    close(fd);
+}
+
+uintmax_t AssemblyCache::evict(uintmax_t targetSize) const {
+    struct Entry {
+        fs::path dir;
+        fs::file_time_type lastUsed;
+        uintmax_t size = 0;
+    };
+    std::vector<Entry> entries;
+    uintmax_t totalSize = 0;
+    std::error_code ec;
+
+    for (fs::directory_iterator dirIter{ m_cacheDir, ec }, end; !ec && dirIter != end;
+         dirIter.increment(ec))
+    {
+        // Leave alone the directories that store() is still filling in.
+        if (dirIter->path().filename().string().find(".tmp.") != std::string::npos) continue;
+
+        fs::path objectPath = dirIter->path() / ObjectFileName;
+        std::error_code entryEc;
+        Entry entry{ dirIter->path(), fs::last_write_time(objectPath, entryEc), 0 };
+
+        if (!entryEc) {
+            entry.size = fs::file_size(objectPath, entryEc);
+        }
+        if (entryEc) continue;
+
+        totalSize += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    if (totalSize <= targetSize) {
+        return totalSize;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& one, const Entry& two) {
+        return one.lastUsed < two.lastUsed;
+    });
+
+    for (const Entry& entry : entries) {
+        if (totalSize <= targetSize) break;
+
+        fs::remove_all(entry.dir, ec);
+        totalSize -= entry.size;
+    }
+    return totalSize;
+}
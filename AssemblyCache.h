@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <util/StringView.h>
+
+// Keeps the output of earlier runs that assembled without any diagnostics,
+// so that assembling the same source again is a lookup. Each entry is a
+// directory named after a SHA-256 of the source together with everything
+// else that can change the output: the assembler's version and the
+// options it was run with.
+//
+// The entries are kept within a size limit, by evicting the ones used least
+// recently whenever storing another goes over it. Their total size is kept in
+// an index file, so that the entries are only scanned when there is something
+// to evict, and then enough are evicted to leave a quarter of the limit free.
+class AssemblyCache {
+public:
+    // Bump whenever the output for a given source changes without the
+    // package version changing, so that stale entries stop matching.
+    static constexpr int FormatVersion = 2;
+
+    static constexpr uintmax_t DefaultMaxSize = uintmax_t{ 32 } << 20;
+
+    AssemblyCache(std::filesystem::path cacheDir, uintmax_t maxSize = DefaultMaxSize) :
+      m_cacheDir{ std::move(cacheDir) },
+      m_maxSize{ maxSize }
+    {}
+
+    // The cache under $XDG_CACHE_HOME/lc3asm, or ~/.cache/lc3asm if that is
+    // not set. Returns nothing if there is no home directory either.
+    static std::optional<AssemblyCache> open();
+
+    static std::string key(Util::StringView src, Util::StringView options);
+
+    // Copies the object file stored under key to outputPath, and marks the
+    // entry as used. Returns false if there is none.
+    bool fetch(const std::string& key, const std::filesystem::path& outputPath) const;
+
+    // Stores a copy of the object file at outputPath under key. The cache
+    // only saves time, so failing to update it is not an error.
+    void store(const std::string& key, const std::filesystem::path& outputPath) const;
+
+private:
+    std::filesystem::path m_cacheDir;
+    uintmax_t m_maxSize;
+
+    // Adds addedSize to the total in the index, evicting entries if that
+    // goes over the limit.
+    void account(uintmax_t addedSize) const;
+
+    // Removes the entries used least recently until the rest come to no more
+    // than targetSize, and returns what they come to.
+    uintmax_t evict(uintmax_t targetSize) const;
+};
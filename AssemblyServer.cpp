@@ -0,0 +1,210 @@
+#include <memory>
+#include <Log.h>
+#include <util/ThreadPool.h>
+#include <util/UnixSocket.h>
+#include <language/SourceFile.h>
+#include <language/SymbolInterner.h>
+#include <language/Parser.h>
+#include <language/SectionMap.h>
+#include <language/Assembler.h>
+#include "AssemblyServer.h"
+
+using Util::UnixSocket;
+using Util::StringView;
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::Assembler;
+using LC3::Language::SectionMap;
+
+// Generous for any real path, while keeping a bad request from asking for
+// much memory.
+static constexpr size_t MaxDirectorySize = 1 << 16;
+
+// Every word of memory, each in a section of its own with its header. A
+// program with more sections than that has empty ones, and the client just
+// assembles it on its own.
+static constexpr uint32_t MaxImageSize =
+    (LC3::Word::maxValue + 1u) * (1 + SectionMap::HeaderSize);
+
+static bool ReadU32(UnixSocket& sock, uint32_t& value) {
+    return sock.readAll(&value, sizeof(value));
+}
+
+static bool WriteU32(UnixSocket& sock, uint32_t value) {
+    return sock.writeAll(&value, sizeof(value));
+}
+
+static bool ReadString(UnixSocket& sock, std::string& str, size_t maxSize) {
+    uint32_t size = 0;
+
+    if (!ReadU32(sock, size) || size > maxSize) {
+        return false;
+    }
+    str.resize(size);
+
+    return sock.readAll(str.data(), size);
+}
+
+static bool WriteString(UnixSocket& sock, StringView str) {
+    return WriteU32(sock, static_cast<uint32_t>(str.size())) &&
+           sock.writeAll(str.data(), str.size());
+}
+
+static bool ReadDiagnostic(UnixSocket& sock, Log::Diagnostic& diag) {
+    uint32_t severity = 0;
+    uint32_t code = 0;
+
+    if (!ReadU32(sock, severity) || severity > static_cast<uint32_t>(Log::Severity::Warning) ||
+        !ReadU32(sock, code) || code > static_cast<uint32_t>(Log::Code::IO))
+    {
+        return false;
+    }
+    diag.severity = static_cast<Log::Severity>(severity);
+    diag.code = static_cast<Log::Code>(code);
+
+    return ReadU32(sock, diag.offset) && ReadU32(sock, diag.lineNum) &&
+           ReadU32(sock, diag.column) &&
+           ReadString(sock, diag.file, MaxDirectorySize) &&
+           ReadString(sock, diag.sourceLine, SourceFile::MaxSize) &&
+           ReadString(sock, diag.message, SourceFile::MaxSize);
+}
+
+static bool WriteDiagnostic(UnixSocket& sock, const Log::Diagnostic& diag) {
+    return WriteU32(sock, static_cast<uint32_t>(diag.severity)) &&
+           WriteU32(sock, static_cast<uint32_t>(diag.code)) &&
+           WriteU32(sock, diag.offset) && WriteU32(sock, diag.lineNum) &&
+           WriteU32(sock, diag.column) &&
+           WriteString(sock, diag.file) &&
+           WriteString(sock, diag.sourceLine) &&
+           WriteString(sock, diag.message);
+}
+
+static bool WriteResult(UnixSocket& sock, const AssemblyServer::Result& result) {
+    std::vector<LC3::WordValue> words;
+    words.reserve(result.image.size());
+
+    for (LC3::Word word : result.image) {
+        words.push_back(word.value());
+    }
+    uint8_t succeeded = result.succeeded ? 1 : 0;
+
+    if (!sock.writeAll(&succeeded, sizeof(succeeded)) ||
+        !WriteU32(sock, static_cast<uint32_t>(result.numErrors)) ||
+        !WriteU32(sock, static_cast<uint32_t>(result.numWarnings)) ||
+        !WriteU32(sock, static_cast<uint32_t>(result.diagnostics.size())))
+    {
+        return false;
+    }
+    for (const Log::Diagnostic& diag : result.diagnostics) {
+        if (!WriteDiagnostic(sock, diag)) {
+            return false;
+        }
+    }
+    return WriteU32(sock, static_cast<uint32_t>(words.size())) &&
+           sock.writeAll(words.data(), words.size() * sizeof(LC3::WordValue));
+}
+
+static void HandleConnection(UnixSocket& sock) {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    std::string src;
+    std::string directory;
+
+    if (!ReadU32(sock, magic) || magic != AssemblyServer::Magic ||
+        !ReadU32(sock, version) || version != AssemblyServer::ProtocolVersion ||
+        !ReadString(sock, src, SourceFile::MaxSize) ||
+        !ReadString(sock, directory, MaxDirectorySize))
+    {
+        return;
+    }
+    // If the client has gone away, there is no one left to tell.
+    WriteResult(sock, AssemblyServer::assemble(src, directory));
+}
+
+bool AssemblyServer::serve(const std::string& path, size_t numThreads) {
+    UnixSocket listener = UnixSocket::listen(path);
+
+    if (!listener) {
+        return false;
+    }
+    Util::ThreadPool pool{ numThreads };
+
+    while (true) {
+        auto sock = std::make_shared<UnixSocket>(listener.accept());
+
+        if (!*sock || !sock->setTimeout(ServerTimeout)) continue;
+
+        pool.submit([sock]() { HandleConnection(*sock); });
+    }
+}
+
+std::optional<AssemblyServer::Result> AssemblyServer::request(const std::string& path,
+                                                              StringView src,
+                                                              StringView directory)
+{
+    UnixSocket sock = UnixSocket::connect(path);
+
+    if (!sock || !sock.setTimeout(ClientTimeout) ||
+        !WriteU32(sock, Magic) || !WriteU32(sock, ProtocolVersion) ||
+        !WriteString(sock, src) || !WriteString(sock, directory))
+    {
+        return std::nullopt;
+    }
+    Result result;
+    uint32_t numErrors = 0;
+    uint32_t numWarnings = 0;
+    uint32_t numDiagnostics = 0;
+    uint32_t numWords = 0;
+    uint8_t succeeded = 0;
+
+    if (!sock.readAll(&succeeded, sizeof(succeeded)) || succeeded > 1 ||
+        !ReadU32(sock, numErrors) || !ReadU32(sock, numWarnings) ||
+        !ReadU32(sock, numDiagnostics) || numDiagnostics > uint64_t{ numErrors } + numWarnings)
+    {
+        return std::nullopt;
+    }
+    result.diagnostics.resize(numDiagnostics);
+
+    for (Log::Diagnostic& diag : result.diagnostics) {
+        if (!ReadDiagnostic(sock, diag)) {
+            return std::nullopt;
+        }
+    }
+    if (!ReadU32(sock, numWords) || numWords > MaxImageSize) {
+        return std::nullopt;
+    }
+    std::vector<LC3::WordValue> words(numWords);
+
+    if (!sock.readAll(words.data(), words.size() * sizeof(LC3::WordValue))) {
+        return std::nullopt;
+    }
+    result.succeeded = succeeded == 1;
+    result.numErrors = numErrors;
+    result.numWarnings = numWarnings;
+    result.image.assign(words.begin(), words.end());
+
+    return result;
+}
+
+AssemblyServer::Result AssemblyServer::assemble(StringView src, const std::string& directory) {
+    Result result;
+    Log::Context logContext;
+    {
+        Log::Scope logScope{ logContext };
+
+        SourceFile srcFile{ src, directory };
+        SourceFile::Scope srcScope{ srcFile };
+
+        SymbolInterner symbols;
+        auto asTree = Parser::parse(srcFile.text(), symbols);
+
+        result.succeeded = asTree && Assembler::assemble(*asTree, symbols, result.image);
+    }
+    result.numErrors = logContext.errorCount();
+    result.numWarnings = logContext.warningCount();
+    result.diagnostics = logContext.diagnostics();
+
+    return result;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+#include <lc3/Word.h>
+#include <Log.h>
+#include <util/StringView.h>
+
+// Assembles programs on behalf of other lc3asm processes, which send their
+// source over a Unix domain socket and get back the image along with the
+// diagnostics. A server that stays up spares each run the cost of starting
+// a process.
+//
+// A request is a header of Magic and ProtocolVersion followed by the source
+// and the client's working directory, which relative .INCLUDE paths are
+// resolved against, each preceded by its length. The reply holds a success
+// flag, the error and warning counts, the diagnostics field by field, and
+// the image. Integers are sent in host byte order, since both ends are on
+// the same machine.
+class AssemblyServer {
+public:
+    static constexpr uint32_t Magic = 0x4C433341;
+    static constexpr uint32_t ProtocolVersion = 5;
+
+    // How long the server waits on a stalled client before dropping it, so
+    // that idle connections cannot hold on to its threads.
+    static constexpr std::chrono::milliseconds ServerTimeout{ 1000 };
+
+    // How long a client waits on the server, including for a thread to
+    // free up and the assembling itself, before assembling on its own.
+    static constexpr std::chrono::milliseconds ClientTimeout{ 10000 };
+
+    struct Result {
+        bool succeeded = false;
+        size_t numErrors = 0;
+        size_t numWarnings = 0;
+        std::vector<Log::Diagnostic> diagnostics;
+        std::vector<LC3::Word> image;
+    };
+
+    // Serves requests on a socket bound to path, numThreads at a time,
+    // until the process is stopped. Returns only if the socket cannot be
+    // set up.
+    static bool serve(const std::string& path, size_t numThreads);
+
+    // Has the server listening at path assemble src. Returns nothing if the
+    // server cannot be reached or the exchange breaks off.
+    static std::optional<Result> request(const std::string& path, Util::StringView src,
+                                         Util::StringView directory);
+
+    // What the server does with each request.
+    static Result assemble(Util::StringView src, const std::string& directory);
+};
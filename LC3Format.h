@@ -0,0 +1,23 @@
+#include <cstddef>
+#include <lc3/Word.h>
+
+#pragma once
+
+// How LC3Writer lays a program out in a file, and how LC3Reader reads it.
+//
+// A program with one section is written the classic way, as its origin
+// followed by its words. One with several is written as a header, which
+// tells it apart from a classic file, followed by a segment for each
+// section: its origin, its length and its words. The memory between
+// sections takes no space in the file.
+struct LC3Format {
+    // The header is the two magic words, the version, then the number of
+    // segments.
+    static constexpr LC3::WordValue Magic[] = { 0x4C33, 0x5347 };
+    static constexpr LC3::WordValue Version = 1;
+    static constexpr size_t HeaderSize = 4;
+
+    // Every segment starts with its origin and its length, as every section
+    // of an image does.
+    static constexpr size_t SegmentHeaderSize = 2;
+};
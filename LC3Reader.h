@@ -1,6 +1,9 @@
+#include <cstddef>
+#include <vector>
 #include <util/BinaryReader.h>
 #include <util/EndiannessConverter.h>
 #include <lc3/Word.h>
+#include <LC3Format.h>
 
 #pragma once
 
@@ -28,4 +31,57 @@ public:
         }
         return false;
     }
+
+    // Reads a program written by LC3Writer::putProgram into an image laid
+    // out the same way it takes one. Returns false if the rest of the file
+    // is not a program, or a section runs past the end of memory.
+    bool getProgram(std::vector<word_type>& image) {
+        std::vector<word_type> words;
+        word_type word;
+
+        while (getWord(word)) {
+            words.push_back(word);
+        }
+        image.clear();
+
+        if (words.empty()) {
+            return false;
+        }
+        if (words.size() < LC3Format::HeaderSize || words[0].value() != LC3Format::Magic[0] ||
+            words[1].value() != LC3Format::Magic[1])
+        {
+            size_t length = words.size() - 1;
+
+            image.push_back(words[0]);
+            image.push_back(static_cast<LC3::WordValue>(length));
+            image.insert(image.end(), words.begin() + 1, words.end());
+
+            return length <= LC3::Word::maxValue && fitsInMemory(words[0], length);
+        }
+        if (words[2].value() != LC3Format::Version) {
+            return false;
+        }
+        size_t numSections = words[3].value();
+        size_t pos = LC3Format::HeaderSize;
+
+        for (size_t i = 0; i < numSections; ++i) {
+            if (pos + LC3Format::SegmentHeaderSize > words.size()) {
+                return false;
+            }
+            size_t length = words[pos + 1].value();
+            size_t end = pos + LC3Format::SegmentHeaderSize + length;
+
+            if (end > words.size() || !fitsInMemory(words[pos], length)) {
+                return false;
+            }
+            image.insert(image.end(), words.begin() + pos, words.begin() + end);
+            pos = end;
+        }
+        return pos == words.size();
+    }
+
+private:
+    static bool fitsInMemory(word_type origin, size_t length) {
+        return origin.value() + length <= LC3::Word::maxValue + size_t{ 1 };
+    }
 };
@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 #include <util/BinaryWriter.h>
 #include <util/EndiannessConverter.h>
 #include <lc3/Word.h>
+#include <LC3Format.h>
 
 #pragma once
 
@@ -21,4 +25,47 @@ public:
     bool putWord(word_type word) {
         return put(word.value());
     }
+
+    // Writes the header that starts a program with several sections.
+    bool putHeader(size_t numSections) {
+        return putWord(LC3Format::Magic[0]) && putWord(LC3Format::Magic[1]) &&
+               putWord(LC3Format::Version) &&
+               putWord(static_cast<LC3::WordValue>(numSections));
+    }
+
+    // Writes an assembled program, laid out as LC3Format describes. In the
+    // image, each section is its origin and its length followed by its
+    // words.
+    bool putProgram(const std::vector<word_type>& image) {
+        constexpr size_t headerSize = LC3Format::SegmentHeaderSize;
+
+        size_t numSections = 0;
+
+        for (size_t pos = 0; pos + headerSize <= image.size();
+             pos += headerSize + image[pos + 1].value())
+        {
+            ++numSections;
+        }
+        bool retStatus = numSections < 2 ||
+                         (numSections <= LC3::Word::maxValue && putHeader(numSections));
+        size_t pos = 0;
+
+        while (pos + headerSize <= image.size()) {
+            size_t length = image[pos + 1].value();
+
+            retStatus = retStatus && putWord(image[pos]);
+
+            if (numSections > 1) {
+                retStatus = retStatus && putWord(image[pos + 1]);
+            }
+            pos += headerSize;
+
+            for (size_t end = std::min(pos + length, image.size()); pos < end; ++pos) {
+                retStatus = retStatus && putWord(image[pos]);
+            }
+        }
+        // Words left over mean a length that does not match, such as one
+        // that did not fit its header.
+        return retStatus && pos == image.size();
+    }
 };
@@ -0,0 +1,149 @@
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <Log.h>
+#include "Linker.h"
+
+using RelocationType = ObjectFile::RelocationType;
+using Binding = ObjectFile::Binding;
+
+static bool FitsSigned(int32_t value, int numBits) {
+    int32_t limit = 1 << (numBits - 1);
+
+    return value >= -limit && value < limit;
+}
+
+static bool ApplyRelocation(const Linker::Module& module, const ObjectFile::Relocation& reloc,
+                            LC3::Word target, LC3::Word place, LC3::Word& word)
+{
+    int numBits = 16;
+    int32_t fieldVal = target.value();
+
+    switch (reloc.type) {
+        case RelocationType::Word:
+            word = target;
+
+            return true;
+        case RelocationType::PcOffset11:
+            numBits = 11;
+            fieldVal = static_cast<int16_t>(target.value() - place.value() - 1);
+            break;
+        case RelocationType::PcOffset9:
+            numBits = 9;
+            fieldVal = static_cast<int16_t>(target.value() - place.value() - 1);
+            break;
+        case RelocationType::Offset6:
+            numBits = 6;
+            fieldVal = static_cast<int16_t>(target.value());
+            break;
+    }
+    const std::string& symName = module.object.symbols[reloc.symbol].name;
+
+    if (!FitsSigned(fieldVal, numBits)) {
+        Log::error(Log::Code::Range) << module.name << ": The reference to " << symName << " at "
+                                     << place << " cannot fit within " << numBits << " bits ("
+                                     << fieldVal << ").\n";
+        return false;
+    }
+    LC3::WordValue fieldMask = (1 << numBits) - 1;
+
+    word = LC3::Word((word.value() & ~fieldMask) | (fieldVal & fieldMask));
+
+    return true;
+}
+
+bool Linker::link(const std::vector<Module>& modules, std::vector<LC3::Word>& image) {
+    // Lay out every section.
+    std::vector<std::vector<LC3::Word>> sectionAddrs(modules.size());
+    std::optional<LC3::Word> startAddr;
+    uint32_t nextAddr = 0;
+
+    for (size_t i = 0; i < modules.size(); ++i) {
+        for (const ObjectFile::Section& section : modules[i].object.sections) {
+            if (!startAddr) {
+                startAddr = section.origin;
+                nextAddr = section.origin.value();
+            }
+            sectionAddrs[i].push_back(static_cast<LC3::WordValue>(nextAddr));
+            nextAddr += static_cast<uint32_t>(section.words.size());
+        }
+    }
+    if (!startAddr) {
+        Log::error(Log::Code::Usage) << "There is nothing to link.\n";
+
+        return false;
+    }
+    // The program is a single section, whose length has to fit its header.
+    if (nextAddr > LC3::Word::maxValue + 1u || nextAddr - startAddr->value() > LC3::Word::maxValue) {
+        Log::error(Log::Code::Section) << "The linked program does not fit in memory.\n";
+
+        return false;
+    }
+    // Match imports to exports.
+    std::unordered_map<std::string, std::pair<LC3::Word, size_t>> exports;
+    bool linkStatus = true;
+
+    for (size_t i = 0; i < modules.size(); ++i) {
+        for (const ObjectFile::Symbol& symbol : modules[i].object.symbols) {
+            if (symbol.binding != Binding::Exported) continue;
+
+            LC3::Word symAddr = sectionAddrs[i][symbol.section] + symbol.offset;
+            auto [exportIter, inserted] = exports.try_emplace(symbol.name, symAddr, i);
+
+            if (!inserted) {
+                Log::error(Log::Code::Symbol) << modules[i].name << ": Symbol " << symbol.name
+                                              << " is also exported by "
+                                              << modules[exportIter->second.second].name << ".\n";
+                linkStatus = false;
+            }
+        }
+    }
+    std::vector<std::vector<std::optional<LC3::Word>>> symAddrs(modules.size());
+
+    for (size_t i = 0; i < modules.size(); ++i) {
+        for (const ObjectFile::Symbol& symbol : modules[i].object.symbols) {
+            std::optional<LC3::Word> symAddr;
+
+            if (symbol.binding != Binding::Imported) {
+                symAddr = sectionAddrs[i][symbol.section] + symbol.offset;
+            } else if (auto exportIter = exports.find(symbol.name); exportIter != exports.end()) {
+                symAddr = exportIter->second.first;
+            } else {
+                Log::error(Log::Code::Symbol) << modules[i].name << ": Undefined symbol " << symbol.name << ".\n";
+                linkStatus = false;
+            }
+            symAddrs[i].push_back(symAddr);
+        }
+    }
+    if (!linkStatus) {
+        return false;
+    }
+    // Copy the sections out and apply their relocations.
+    image.clear();
+    image.push_back(*startAddr);
+    image.push_back(0);
+
+    for (size_t i = 0; i < modules.size(); ++i) {
+        const auto& sections = modules[i].object.sections;
+
+        for (size_t j = 0; j < sections.size(); ++j) {
+            size_t sectionStart = image.size();
+
+            image.insert(image.end(), sections[j].words.begin(), sections[j].words.end());
+
+            for (const ObjectFile::Relocation& reloc : sections[j].relocations) {
+                LC3::Word place = sectionAddrs[i][j] + reloc.offset;
+
+                if (!ApplyRelocation(modules[i], reloc, *symAddrs[i][reloc.symbol], place,
+                                     image[sectionStart + reloc.offset]))
+                {
+                    linkStatus = false;
+                }
+            }
+        }
+    }
+    // Everything went into a single section.
+    image[1] = static_cast<LC3::WordValue>(image.size() - 2);
+
+    return linkStatus;
+}
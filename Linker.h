@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <lc3/Word.h>
+#include "ObjectFile.h"
+
+// Combines relocatable objects into a single program.
+//
+// Sections are laid out in the order given. The first keeps the address
+// of its .ORIG, and each one after it is placed right after the one
+// before, so a library needs no fixed address of its own. Once every
+// section has its final address, each imported symbol is matched to the
+// module that exports it and the relocations are applied.
+class Linker {
+public:
+    struct Module {
+        std::string name;
+        ObjectFile object;
+    };
+
+    // The image has the same layout as the assembler's, holding the whole
+    // program in a single section. Problems are reported through
+    // Log, naming the module they were found in.
+    static bool link(const std::vector<Module>& modules, std::vector<LC3::Word>& image);
+};
@@ -1,28 +1,325 @@
+#include <atomic>
+#include <cstdio>
+#include <sstream>
 #include "Log.h"
 
-static size_t numErrors = 0;
-static size_t numWarnings = 0;
+static thread_local Log::Context* t_activeContext = nullptr;
+static std::atomic<size_t> s_maxErrors{ 0 };
+
+namespace {
+
+// Reports whatever it still holds at exit, for programs that never flush.
+class DefaultContext : public Log::Context {
+public:
+    ~DefaultContext() {
+        if (!diagnostics().empty()) {
+            render(std::cerr, Log::Format::Text);
+        }
+    }
+};
+
+} // namespace
+
+Log::Context& Log::activeContext() {
+    static DefaultContext defaultContext;
+
+    return t_activeContext != nullptr ? *t_activeContext : defaultContext;
+}
+
+Log::Context::Context() {
+    retarget();
+}
+
+Log::Context::MessageBuffer::int_type Log::Context::MessageBuffer::overflow(int_type ch) {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        m_target->push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize Log::Context::MessageBuffer::xsputn(const char* str, std::streamsize count) {
+    m_target->append(str, static_cast<size_t>(count));
+
+    return count;
+}
+
+// Points the stream at the message of the last diagnostic kept, or at the
+// dropped one if there is none.
+void Log::Context::retarget() {
+    m_messageBuffer.setTarget(m_diagnostics.empty() ? m_dropped.message :
+                                                      m_diagnostics.back().message);
+}
+
+Log::Diagnostic& Log::Context::add(Severity severity) {
+    size_t maxErrors = s_maxErrors;
+
+    if (severity == Severity::Error) {
+        ++m_numErrors;
+
+        if (maxErrors != 0 && m_numShownErrors == maxErrors) {
+            m_dropped = Diagnostic{};
+            m_messageBuffer.setTarget(m_dropped.message);
+
+            return m_dropped;
+        }
+        ++m_numShownErrors;
+    } else {
+        ++m_numWarnings;
+    }
+    m_diagnostics.emplace_back();
+    m_diagnostics.back().severity = severity;
+    m_messageBuffer.setTarget(m_diagnostics.back().message);
+
+    return m_diagnostics.back();
+}
+
+// Keeps a diagnostic that has already been counted.
+void Log::Context::append(Diagnostic&& diag) {
+    size_t maxErrors = s_maxErrors;
+
+    if (diag.severity == Severity::Error) {
+        if (maxErrors != 0 && m_numShownErrors == maxErrors) {
+            return;
+        }
+        ++m_numShownErrors;
+    }
+    m_diagnostics.push_back(std::move(diag));
+}
+
+void Log::Context::clear() {
+    m_diagnostics.clear();
+    m_diagnostics.shrink_to_fit();
+
+    retarget();
+}
+
+static void AppendText(std::string& out, const Log::Diagnostic& diag) {
+    out += (diag.severity == Log::Severity::Error) ? "Error: " : "Warning: ";
+
+    if (diag.offset != Log::Diagnostic::NoOffset) {
+        out += '[';
+
+        if (diag.lineNum == 0) {
+            out += '@';
+            out += std::to_string(diag.offset);
+        } else {
+            if (!diag.file.empty()) {
+                out += diag.file;
+                out += ':';
+            }
+            out += std::to_string(diag.lineNum);
+            out += ':';
+            out += std::to_string(diag.column);
+        }
+        out += "]\n";
+
+        if (diag.lineNum != 0) {
+            out += diag.sourceLine;
+            out += '\n';
+            out.append(diag.column, ' ');
+            out += "^\n";
+        }
+    }
+    out += diag.message;
+}
+
+static void AppendJsonString(std::string& out, const std::string& str) {
+    out += '"';
+
+    for (char ch : str) {
+        switch (ch) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                char escape[8];
+
+                std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(ch));
+                out += escape;
+            } else {
+                out += ch;
+            }
+        }
+    }
+    out += '"';
+}
+
+static void AppendJson(std::string& out, const Log::Diagnostic& diag, const std::string& mainFile) {
+    out += "{\"severity\":";
+    out += (diag.severity == Log::Severity::Error) ? "\"error\"" : "\"warning\"";
+    out += ",\"code\":\"";
+    out += Log::codeName(diag.code);
+    out += '"';
+
+    const std::string& file = diag.file.empty() ? mainFile : diag.file;
+
+    if (!file.empty()) {
+        out += ",\"file\":";
+        AppendJsonString(out, file);
+    }
+    if (diag.offset != Log::Diagnostic::NoOffset) {
+        out += ",\"offset\":";
+        out += std::to_string(diag.offset);
+    }
+    if (diag.lineNum != 0) {
+        out += ",\"line\":";
+        out += std::to_string(diag.lineNum);
+        out += ",\"column\":";
+        out += std::to_string(diag.column);
+    }
+    // The trailing linebreak every message ends with is left out.
+    std::string message = diag.message;
+
+    if (!message.empty() && message.back() == '\n') {
+        message.pop_back();
+    }
+    out += ",\"message\":";
+    AppendJsonString(out, message);
+    out += "}\n";
+}
+
+void Log::Context::render(std::ostream& outStream, Format format, const std::string& mainFile) const {
+    std::string out;
+
+    for (const Diagnostic& diag : m_diagnostics) {
+        if (format == Format::Text) {
+            AppendText(out, diag);
+        } else {
+            AppendJson(out, diag, mainFile);
+        }
+    }
+    if (format == Format::Text && m_numErrors > m_numShownErrors) {
+        size_t numHidden = m_numErrors - m_numShownErrors;
+
+        out += "Too many errors; " + std::to_string(numHidden) +
+               (numHidden == 1 ? " more was not shown.\n" : " more were not shown.\n");
+    }
+    outStream.write(out.data(), static_cast<std::streamsize>(out.size()));
+}
+
+std::string Log::Context::text() const {
+    std::ostringstream outStream;
+
+    render(outStream, Format::Text);
+
+    return outStream.str();
+}
+
+Log::Scope::Scope(Context& context) :
+  m_prevContext{ t_activeContext }
+{
+    t_activeContext = &context;
+}
+
+Log::Scope::~Scope() {
+    t_activeContext = m_prevContext;
+}
+
+namespace {
+
+// The location of a diagnostic that is not about a place in the source.
+struct NoLocation {
+    void locate(Log::Diagnostic&) const {}
+};
+
+} // namespace
+
+std::ostream& Log::error(Code code) {
+    return report(Severity::Error, code, NoLocation{});
+}
 
 std::ostream& Log::error(bool newError) {
+    Context& context = activeContext();
+
     if (newError) {
-        ++numErrors;
-        std::cerr << "Error: ";
+        return report(Severity::Error, Code::General, NoLocation{});
     }
-    return std::cerr;
+    return context.m_stream;
 }
 
 size_t Log::errorCount() {
-    return numErrors;
+    return activeContext().m_numErrors;
+}
+
+std::ostream& Log::warning(Code code) {
+    return report(Severity::Warning, code, NoLocation{});
 }
 
 std::ostream& Log::warning(bool newWarning) {
+    Context& context = activeContext();
+
     if (newWarning) {
-        ++numWarnings;
-        std::cerr << "Warning: ";
+        return report(Severity::Warning, Code::General, NoLocation{});
     }
-    return std::cerr;
+    return context.m_stream;
 }
 
 size_t Log::warningCount() {
-    return numWarnings;
+    return activeContext().m_numWarnings;
+}
+
+const char* Log::codeName(Code code) {
+    switch (code) {
+    case Code::General:
+        return "general";
+    case Code::Usage:
+        return "usage";
+    case Code::Syntax:
+        return "syntax";
+    case Code::Symbol:
+        return "symbol";
+    case Code::Range:
+        return "range";
+    case Code::Section:
+        return "section";
+    case Code::IO:
+        return "io";
+    }
+    return "general";
+}
+
+void Log::setMaxErrors(size_t maxErrors) {
+    s_maxErrors = maxErrors;
+}
+
+void Log::merge(Context& other) {
+    Context& context = activeContext();
+
+    context.m_numErrors += other.m_numErrors;
+    context.m_numWarnings += other.m_numWarnings;
+
+    for (Diagnostic& diag : other.m_diagnostics) {
+        context.append(std::move(diag));
+    }
+    other.clear();
+    context.retarget();
+}
+
+void Log::merge(std::vector<Diagnostic> diagnostics, size_t numErrors, size_t numWarnings) {
+    Context& context = activeContext();
+
+    context.m_numErrors += numErrors;
+    context.m_numWarnings += numWarnings;
+
+    for (Diagnostic& diag : diagnostics) {
+        context.append(std::move(diag));
+    }
+    context.retarget();
+}
+
+void Log::flush(std::ostream& outStream, Format format, const std::string& mainFile) {
+    Context& context = activeContext();
+
+    context.render(outStream, format, mainFile);
+    context.clear();
 }
@@ -1,22 +1,204 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
 
 class Log {
 public:
+    enum class Severity : uint8_t {
+        Error,
+        Warning
+    };
+
+    // What a diagnostic is about, so that tools can tell kinds of problems
+    // apart without matching on messages.
+    enum class Code : uint8_t {
+        General,
+        // The command line.
+        Usage,
+        // Text that does not parse or is not a valid statement.
+        Syntax,
+        // Labels and other symbols that are undefined or defined twice.
+        Symbol,
+        // Numbers and offsets that do not fit their field.
+        Range,
+        // Where code and data are placed in memory.
+        Section,
+        // Files that cannot be read or written.
+        IO
+    };
+
+    // How buffered diagnostics are written out: as the familiar messages
+    // with source context, or as one JSON object per line for tools.
+    enum class Format {
+        Text,
+        JsonLines
+    };
+
+    // A single error or warning. Where it points is resolved when it is
+    // reported, so it can still be rendered once the source is gone.
+    struct Diagnostic {
+        static constexpr uint32_t NoOffset = UINT32_MAX;
+
+        Severity severity = Severity::Error;
+        Code code = Code::General;
+
+        // The byte offset into the file the diagnostic is in, or NoOffset if
+        // it is not about a place in the source.
+        uint32_t offset = NoOffset;
+
+        // The 1-based line and 0-based column of the offset, or a line of 0
+        // if it could not be resolved to a file.
+        uint32_t lineNum = 0;
+        uint32_t column = 0;
+
+        // The name of the included file the offset is in. Empty for the
+        // main source.
+        std::string file;
+
+        std::string sourceLine;
+        std::string message;
+    };
+
     template <typename T>
-    static std::ostream& error(const T& errObj) {
-        return errObj.errorPrefix(Log::error());
+    static std::ostream& error(const T& errObj, Code code = Code::General) {
+        return report(Severity::Error, code, errObj);
     }
 
+    static std::ostream& error(Code code);
     static std::ostream& error(bool newError = true);
     static size_t errorCount();
 
     template <typename T>
-    static std::ostream& warning(const T& warnObj) {
-        return warnObj.errorPrefix(Log::warning());
+    static std::ostream& warning(const T& warnObj, Code code = Code::General) {
+        return report(Severity::Warning, code, warnObj);
     }
 
+    static std::ostream& warning(Code code);
     static std::ostream& warning(bool newWarning = true);
     static size_t warningCount();
+
+    // The name a code goes by in JSON.
+    static const char* codeName(Code code);
+
+    // Diagnostics are collected by, and counted by, the context that is
+    // active on the calling thread. Without one, they go to a process-wide
+    // context that is rendered to std::cerr by flush() or at exit. Jobs
+    // that run concurrently each use a context of their own.
+    //
+    // Nothing is formatted until a context is rendered, and then all of it
+    // is written at once.
+    class Context {
+    public:
+        Context();
+
+        Context(const Context& other) = delete;
+        Context& operator = (const Context& other) = delete;
+
+        size_t errorCount() const {
+            return m_numErrors;
+        }
+        size_t warningCount() const {
+            return m_numWarnings;
+        }
+
+        // Every diagnostic reported so far, in order, except for errors past
+        // the limit set by setMaxErrors().
+        const std::vector<Diagnostic>& diagnostics() const {
+            return m_diagnostics;
+        }
+
+        // Writes out the diagnostics. Those in the main source are named
+        // mainFile in JSON, where every line has to stand on its own.
+        void render(std::ostream& outStream, Format format,
+                    const std::string& mainFile = {}) const;
+
+        // The diagnostics rendered as text.
+        std::string text() const;
+
+        void clear();
+
+    private:
+        // Appends whatever is written to the message of the diagnostic
+        // reported last.
+        class MessageBuffer : public std::streambuf {
+        public:
+            void setTarget(std::string& target) {
+                m_target = &target;
+            }
+
+        protected:
+            int_type overflow(int_type ch) override;
+            std::streamsize xsputn(const char* str, std::streamsize count) override;
+
+        private:
+            std::string* m_target = nullptr;
+        };
+
+        Diagnostic& add(Severity severity);
+        void append(Diagnostic&& diag);
+        void retarget();
+
+        std::vector<Diagnostic> m_diagnostics;
+        size_t m_numShownErrors = 0;
+
+        // Takes in the errors past the limit, which are counted but not kept.
+        Diagnostic m_dropped;
+
+        MessageBuffer m_messageBuffer;
+        std::ostream m_stream{ &m_messageBuffer };
+
+        size_t m_numErrors = 0;
+        size_t m_numWarnings = 0;
+
+        friend class Log;
+    };
+
+    // Makes a context active on the current thread for as long as it lives.
+    class Scope {
+    public:
+        Scope(Context& context);
+        ~Scope();
+
+        Scope(const Scope& other) = delete;
+        Scope& operator = (const Scope& other) = delete;
+
+    private:
+        Context* m_prevContext;
+    };
+
+    // Errors past this many in a context are still counted, but are neither
+    // kept nor shown. Zero, the default, keeps them all.
+    static void setMaxErrors(size_t maxErrors);
+
+    // Moves the diagnostics of another context to the end of the active
+    // one, and adds its counts to the active one's.
+    static void merge(Context& other);
+
+    // The same, for diagnostics that were collected somewhere else entirely,
+    // such as in an assembly server.
+    static void merge(std::vector<Diagnostic> diagnostics, size_t numErrors, size_t numWarnings);
+
+    // Renders the active context's diagnostics and then discards them. The
+    // counts are kept.
+    static void flush(std::ostream& outStream, Format format = Format::Text,
+                      const std::string& mainFile = {});
+
+private:
+    template <typename T>
+    static std::ostream& report(Severity severity, Code code, const T& obj) {
+        Context& context = activeContext();
+        Diagnostic& diag = context.add(severity);
+
+        diag.code = code;
+        obj.locate(diag);
+
+        return context.m_stream;
+    }
+
+    static Context& activeContext();
 };
@@ -0,0 +1,146 @@
+#include <util/BinaryReader.h>
+#include <util/BinaryWriter.h>
+#include <util/EndiannessConverter.h>
+#include "ObjectFile.h"
+
+using Writer = Util::BinaryWriter<Util::EndiannessConverter<Util::BigEndian>>;
+using Reader = Util::BinaryReader<Util::EndiannessConverter<Util::BigEndian>>;
+
+bool ObjectFile::write(const char* fileName) const {
+    Writer writer{ fileName };
+
+    if (!writer) {
+        return false;
+    }
+    bool status = writer.put(Magic) && writer.put(Version) &&
+                  writer.put(static_cast<uint32_t>(sections.size()));
+
+    for (const Section& section : sections) {
+        status = status && writer.put(section.origin.value()) &&
+                 writer.put(static_cast<uint32_t>(section.words.size()));
+
+        for (LC3::Word word : section.words) {
+            status = status && writer.put(word.value());
+        }
+        status = status && writer.put(static_cast<uint32_t>(section.relocations.size()));
+
+        for (const Relocation& reloc : section.relocations) {
+            status = status && writer.put(reloc.offset) &&
+                     writer.put(static_cast<uint8_t>(reloc.type)) &&
+                     writer.put(reloc.symbol);
+        }
+    }
+    status = status && writer.put(static_cast<uint32_t>(symbols.size()));
+
+    for (const Symbol& symbol : symbols) {
+        status = status && writer.put(static_cast<uint8_t>(symbol.binding)) &&
+                 writer.put(symbol.section) && writer.put(symbol.offset) &&
+                 writer.put(static_cast<uint32_t>(symbol.name.size()));
+
+        for (char c : symbol.name) {
+            status = status && writer.put(static_cast<uint8_t>(c));
+        }
+    }
+    return status;
+}
+
+// Counts are checked against what the format allows before anything is
+// allocated for them, so a damaged file cannot ask for gigabytes.
+static constexpr uint32_t MaxCount = LC3::Word::maxValue + 1u;
+
+std::optional<ObjectFile> ObjectFile::read(const char* fileName) {
+    Reader reader{ fileName };
+    ObjectFile object;
+
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint32_t numSections = 0;
+
+    if (!reader || !reader.get(magic) || magic != Magic ||
+        !reader.get(version) || version != Version ||
+        !reader.get(numSections) || numSections > MaxCount)
+    {
+        return std::nullopt;
+    }
+    object.sections.resize(numSections);
+
+    for (Section& section : object.sections) {
+        LC3::WordValue origin = 0;
+        uint32_t numWords = 0;
+        uint32_t numRelocs = 0;
+
+        if (!reader.get(origin) || !reader.get(numWords) || numWords > MaxCount) {
+            return std::nullopt;
+        }
+        section.origin = origin;
+        section.words.resize(numWords);
+
+        for (LC3::Word& word : section.words) {
+            LC3::WordValue wordVal = 0;
+
+            if (!reader.get(wordVal)) {
+                return std::nullopt;
+            }
+            word = wordVal;
+        }
+        if (!reader.get(numRelocs) || numRelocs > MaxCount) {
+            return std::nullopt;
+        }
+        section.relocations.resize(numRelocs);
+
+        for (Relocation& reloc : section.relocations) {
+            uint8_t type = 0;
+
+            if (!reader.get(reloc.offset) || !reader.get(type) || !reader.get(reloc.symbol) ||
+                reloc.offset >= numWords || type > static_cast<uint8_t>(RelocationType::Offset6))
+            {
+                return std::nullopt;
+            }
+            reloc.type = static_cast<RelocationType>(type);
+        }
+    }
+    uint32_t numSymbols = 0;
+
+    if (!reader.get(numSymbols) || numSymbols > MaxCount) {
+        return std::nullopt;
+    }
+    object.symbols.resize(numSymbols);
+
+    for (Symbol& symbol : object.symbols) {
+        uint8_t binding = 0;
+        uint32_t nameSize = 0;
+
+        if (!reader.get(binding) || binding > static_cast<uint8_t>(Binding::Imported) ||
+            !reader.get(symbol.section) || !reader.get(symbol.offset) ||
+            !reader.get(nameSize) || nameSize > MaxCount)
+        {
+            return std::nullopt;
+        }
+        symbol.binding = static_cast<Binding>(binding);
+
+        if (symbol.binding != Binding::Imported &&
+            (symbol.section >= numSections ||
+             symbol.offset > object.sections[symbol.section].words.size()))
+        {
+            return std::nullopt;
+        }
+        symbol.name.resize(nameSize);
+
+        for (char& c : symbol.name) {
+            uint8_t byte = 0;
+
+            if (!reader.get(byte)) {
+                return std::nullopt;
+            }
+            c = static_cast<char>(byte);
+        }
+    }
+    for (const Section& section : object.sections) {
+        for (const Relocation& reloc : section.relocations) {
+            if (reloc.symbol >= numSymbols) {
+                return std::nullopt;
+            }
+        }
+    }
+    return object;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <lc3/Word.h>
+
+// A relocatable module, as written by lc3asm -c and combined by lc3ld.
+//
+// Each section is a run of words assembled as if it started at its origin.
+// Symbols are named addresses within a section, or names imported from
+// another module. A relocation marks a field whose value depends on where
+// a symbol ends up: any field that refers to an imported symbol, and any
+// field that holds a symbol's absolute address, and any PC-relative field
+// that refers to another section. PC-relative references within a section
+// need none, since they do not change when the section moves as a whole.
+struct ObjectFile {
+    static constexpr uint32_t Magic = 0x4C33524F;
+    static constexpr uint16_t Version = 1;
+
+    enum class RelocationType : uint8_t {
+        // The whole word holds the symbol's address, as in .FILL.
+        Word,
+
+        // The low bits hold the symbol's offset from the next instruction.
+        PcOffset11,
+        PcOffset9,
+
+        // The low 6 bits hold the symbol's address, which must fit.
+        Offset6
+    };
+
+    enum class Binding : uint8_t {
+        Local,
+        Exported,
+        Imported
+    };
+
+    struct Symbol {
+        std::string name;
+        Binding binding = Binding::Local;
+
+        // Where a symbol that is not imported is defined.
+        uint32_t section = 0;
+        uint32_t offset = 0;
+    };
+
+    struct Relocation {
+        uint32_t offset = 0;
+        RelocationType type = RelocationType::Word;
+        uint32_t symbol = 0;
+    };
+
+    struct Section {
+        LC3::Word origin;
+        std::vector<LC3::Word> words;
+        std::vector<Relocation> relocations;
+    };
+
+    std::vector<Section> sections;
+    std::vector<Symbol> symbols;
+
+    bool write(const char* fileName) const;
+
+    // Returns nothing if the file cannot be read or is not a well-formed
+    // object file.
+    static std::optional<ObjectFile> read(const char* fileName);
+};
@@ -0,0 +1,212 @@
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <lc3/Word.h>
+#include <Log.h>
+#include "keywords/Directives.h"
+#include "TreeNodes.h"
+#include "Encoder.h"
+#include "SectionMap.h"
+#include "Assembler.h"
+
+namespace LC3::Language {
+
+using Keywords::Directive;
+
+Assembler::Assembler(const SymbolInterner& symbols) :
+  m_symTable{ symbols },
+  m_definedSyms(symbols.size(), false)
+{}
+
+bool Assembler::assemble(SyntaxTreeNode& root, const SymbolInterner& symbols,
+                         LC3Writer& writer)
+{
+    std::vector<LC3::Word> image;
+
+    if (!assemble(root, symbols, image)) {
+        return false;
+    }
+    return writer.putProgram(image);
+}
+
+bool Assembler::assemble(SyntaxTreeNode& root, const SymbolInterner& symbols,
+                         std::vector<LC3::Word>& image)
+{
+    assert(root.type == NodeType::Root);
+
+    Assembler assembler{ symbols };
+
+    for (SyntaxTreeNode& node : root.children) {
+        if (assembler.terminated()) break;
+
+        assembler.add(std::move(node));
+    }
+    return assembler.finish(image);
+}
+
+void Assembler::add(SyntaxTreeNode&& node) {
+    switch (node.type) {
+        case NodeType::LabelDefn:
+            addLabel(node);
+            break;
+        case NodeType::Instruction:
+        case NodeType::Directive:
+            addStatement(std::move(node));
+            break;
+        default:
+            break;
+    }
+}
+
+void Assembler::reserveSymbol(SymbolId symbolId) {
+    if (symbolId >= m_definedSyms.size()) {
+        m_definedSyms.resize(symbolId + 1, false);
+        m_symTable.grow(symbolId + 1);
+    }
+}
+
+void Assembler::addLabel(const SyntaxTreeNode& node) {
+    SymbolId symbolId = node.data<LabelDefnNode>();
+
+    reserveSymbol(symbolId);
+
+    if (m_definedSyms[symbolId]) {
+        m_redefinedSyms.push_back(node.token);
+    } else {
+        m_definedSyms[symbolId] = true;
+        m_pendingSyms.push_back(symbolId);
+    }
+}
+
+bool Assembler::hasUnresolvedRefs(const SyntaxTreeNode& node) const {
+    for (const SyntaxTreeNode& child : node.children) {
+        if (child.type == NodeType::LabelRef && !m_symTable.has(child.data<LabelRefNode>())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Assembler::isValid() const {
+    return m_analysisStatus && m_redefinedSyms.empty() && m_unaddressedSyms.empty();
+}
+
+void Assembler::addStatement(SyntaxTreeNode&& node) {
+    if (!m_analyzer.analyzeStatement(node)) {
+        m_analysisStatus = false;
+
+        return;
+    }
+    for (const SyntaxTreeNode& child : node.children) {
+        if (child.type != NodeType::LabelRef) continue;
+
+        SymbolId symbolId = child.data<LabelRefNode>();
+
+        reserveSymbol(symbolId);
+
+        if (!m_definedSyms[symbolId]) {
+            m_forwardRefs.push_back({ symbolId, child.token });
+        }
+    }
+    m_progCounter.update(node);
+
+    if (node.type == NodeType::Directive &&
+        node.data<DirectiveNode>() == Directive::END)
+    {
+        if (!m_pendingSyms.empty()) {
+            m_unaddressedSyms.push_back(node.token);
+        }
+    } else {
+        for (SymbolId symbolId : m_pendingSyms) {
+            m_symTable.add(symbolId, m_progCounter.address());
+        }
+        m_pendingSyms.clear();
+    }
+    // Nothing gets written once the program is known to be invalid, so
+    // there is no point in encoding the rest of it.
+    if (!isValid()) {
+        return;
+    }
+    size_t imageOffset = m_image.size();
+    size_t stmtSize = Encoder::statementSize(node);
+
+    bool isOrig = node.type == NodeType::Directive &&
+                  node.data<DirectiveNode>() == Directive::ORIG;
+
+    if (isOrig) {
+        m_sections.push_back({ imageOffset, node.token });
+    }
+    if (m_recordPlacements && (isOrig || stmtSize > 0)) {
+        size_t headerSize = isOrig ? SectionMap::HeaderSize : 0;
+
+        m_placements.push_back({ node.token.location, m_progCounter.address(),
+                                 static_cast<uint32_t>(imageOffset + headerSize),
+                                 static_cast<uint32_t>(stmtSize - headerSize) });
+    }
+
+    if (!hasUnresolvedRefs(node)) {
+        Log::Scope droppedScope{ m_droppedLog };
+
+        if (Encoder::encodeStatement(node, m_symTable, m_progCounter, m_image, imageOffset)) {
+            return;
+        }
+        m_droppedLog.clear();
+    }
+    m_image.resize(imageOffset + stmtSize);
+    m_fixups.push_back({ std::move(node), m_progCounter, imageOffset });
+}
+
+bool Assembler::finish(LC3Writer& writer) {
+    std::vector<LC3::Word> image;
+
+    if (!finish(image)) {
+        return false;
+    }
+    return writer.putProgram(image);
+}
+
+bool Assembler::finish(std::vector<LC3::Word>& image) {
+    m_analyzer.finish();
+
+    if (!m_analysisStatus) {
+        return false;
+    }
+    bool symbolStatus = m_redefinedSyms.empty();
+
+    for (const Token& defnToken : m_redefinedSyms) {
+        Log::error(defnToken, Log::Code::Symbol) << "Symbol has multiple definitions.\n";
+    }
+    for (const SymbolUse& ref : m_forwardRefs) {
+        if (!m_definedSyms[ref.symbolId]) {
+            Log::error(ref.token, Log::Code::Symbol) << "Reference to undefined symbol.\n";
+            symbolStatus = false;
+        }
+    }
+    if (!symbolStatus) {
+        return false;
+    }
+    for (const Token& endToken : m_unaddressedSyms) {
+        Log::error(endToken, Log::Code::Section) << "Label to unaddressed memory.\n";
+    }
+    if (!m_unaddressedSyms.empty()) {
+        return false;
+    }
+    bool encodeStatus = true;
+
+    for (const Fixup& fixup : m_fixups) {
+        if (!Encoder::encodeStatement(fixup.node, m_symTable, fixup.progCounter,
+                                      m_image, fixup.imageOffset))
+        {
+            encodeStatus = false;
+        }
+    }
+    if (!encodeStatus || !SectionMap::finish(m_image, m_sections)) {
+        return false;
+    }
+    image = std::move(m_image);
+
+    return true;
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <LC3Writer.h>
+#include <Log.h>
+#include <lc3/Word.h>
+#include "SymbolInterner.h"
+#include "SymbolTable.h"
+#include "SyntaxTreeNode.h"
+#include "Token.h"
+#include "SourceLocation.h"
+#include "TreeAnalyzer.h"
+#include "SectionMap.h"
+#include "ProgramCounter.h"
+
+namespace LC3::Language {
+
+// Assembles a parsed program in a single forward walk over its statements,
+// checking each one, assigning its address and encoding it in turn. A
+// statement that refers to a label defined further down is recorded as a
+// fixup and encoded again once every label has an address. The output is
+// the same as running TreeAnalyzer, SymbolTable and Encoder one after the
+// other.
+//
+// Statements are handed over one at a time and only those held for a
+// fixup are kept, so the whole tree never has to exist at once.
+class Assembler {
+public:
+    // Where a statement ended up, for listings. Its words are the ones it
+    // puts in the program, so an .ORIG has none.
+    struct Placement {
+        SourceLocation location;
+        LC3::Word address;
+        uint32_t imageOffset = 0;
+        uint32_t numWords = 0;
+    };
+
+    Assembler(const SymbolInterner& symbols);
+
+    Assembler(const Assembler& other) = delete;
+    Assembler& operator = (const Assembler& other) = delete;
+
+    // Takes the next top-level node of the program.
+    void add(SyntaxTreeNode&& node);
+
+    // Resolves the fixups and, if the program is valid, writes its image.
+    bool finish(LC3Writer& writer);
+
+    // As above, but hands the image over instead of writing it.
+    bool finish(std::vector<LC3::Word>& image);
+
+    // Set once an error was found that makes the rest of the program moot.
+    bool terminated() const {
+        return m_analyzer.terminated();
+    }
+
+    // Has the placement of every statement added from now on recorded.
+    void recordPlacements() {
+        m_recordPlacements = true;
+    }
+
+    // Every .ORIG and every statement that takes up memory, in the order
+    // they were added.
+    const std::vector<Placement>& placements() const {
+        return m_placements;
+    }
+
+    const SymbolTable& symbolTable() const {
+        return m_symTable;
+    }
+
+    static bool assemble(SyntaxTreeNode& root, const SymbolInterner& symbols,
+                         LC3Writer& writer);
+    static bool assemble(SyntaxTreeNode& root, const SymbolInterner& symbols,
+                         std::vector<LC3::Word>& image);
+
+private:
+    struct Fixup {
+        SyntaxTreeNode node;
+        ProgramCounter progCounter;
+        size_t imageOffset = 0;
+    };
+
+    struct SymbolUse {
+        SymbolId symbolId = 0;
+        Token token;
+    };
+
+    void addLabel(const SyntaxTreeNode& node);
+    void addStatement(SyntaxTreeNode&& node);
+    void reserveSymbol(SymbolId symbolId);
+    bool hasUnresolvedRefs(const SyntaxTreeNode& node) const;
+    bool isValid() const;
+
+    TreeAnalyzer m_analyzer;
+    SymbolTable m_symTable;
+    ProgramCounter m_progCounter;
+
+    bool m_analysisStatus = true;
+
+    std::vector<bool> m_definedSyms;
+    std::vector<SymbolId> m_pendingSyms;
+
+    // Symbol errors are only reported once the whole program has passed
+    // analysis, in the same order as SymbolTable::make reports them.
+    std::vector<SymbolUse> m_forwardRefs;
+    std::vector<Token> m_redefinedSyms;
+    std::vector<Token> m_unaddressedSyms;
+
+    std::vector<LC3::Word> m_image;
+    std::vector<SectionMap::Section> m_sections;
+    std::vector<Fixup> m_fixups;
+
+    bool m_recordPlacements = false;
+    std::vector<Placement> m_placements;
+
+    // A statement that fails to encode right away is encoded again with the
+    // fixups, so that encoder errors come out in statement order. The
+    // diagnostics of the first attempt are dropped.
+    Log::Context m_droppedLog;
+};
+
+} // namespace LC3::Language
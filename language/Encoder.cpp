@@ -1,62 +1,254 @@
 #include <cassert>
+#include <cstdint>
 #include <stdexcept>
 #include <optional>
+#include <algorithm>
+#include <memory>
 #include <lc3/Word.h>
 #include <Log.h>
+#include <util/ThreadPool.h>
 #include "keywords/Instructions.h"
+#include "keywords/InstructionForms.h"
 #include "keywords/Directives.h"
 #include "TreeNodes.h"
 #include "ProgramCounter.h"
+#include "SourceFile.h"
+#include "SectionMap.h"
 #include "Encoder.h"
 
 namespace LC3::Language {
 
 using Keywords::Directive;
 using Keywords::Instruction;
-using Keywords::Instructions;
-
+using Keywords::InstructionForm;
+using Keywords::InstructionForms;
+using Keywords::OperandField;
+using Keywords::OperandKind;
+
+template <typename WriterT>
+static bool EncodeStatement(const SyntaxTreeNode& node, const SymbolTable& symTable,
+                            const ProgramCounter& progCounter, WriterT& writer);
+template <typename WriterT>
 static bool EncodeDirective(const SyntaxTreeNode& dirNode, const SymbolTable& symTable,
-                            const ProgramCounter& progCounter, LC3Writer& writer);
+                            const ProgramCounter& progCounter, WriterT& writer);
+template <typename WriterT>
 static bool EncodeInstruction(const SyntaxTreeNode& instrNode, const SymbolTable& symTable,
-                              const ProgramCounter& progCounter, LC3Writer& writer);
+                              const ProgramCounter& progCounter, WriterT& writer);
 
 static LC3::Word GetNodeValue(const SyntaxTreeNode& treeNode, const SymbolTable& symTable);
 
 static std::optional<LC3::Word> RestrictWidth(LC3::Word word, size_t numBits);
 static std::optional<LC3::Word> RestrictWidthSigned(LC3::Word word, size_t numBits);
 
+static bool IsOrigDirective(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Directive && node.data<DirectiveNode>() == Directive::ORIG;
+}
+
 bool Encoder::encode(const SyntaxTreeNode& rootNode, const SymbolTable& symTable,
                      LC3Writer& writer)
 {
     assert(rootNode.type == NodeType::Root);
 
     ProgramCounter progCounter;
+    std::vector<LC3::Word> image;
+    std::vector<SectionMap::Section> sections;
     bool encodeStatus = true;
 
     for (const SyntaxTreeNode& childNode : rootNode.children) {
-        bool status = true;
-
         progCounter.update(childNode);
 
-        switch (childNode.type) {
-            case NodeType::Directive:
-                status = EncodeDirective(childNode, symTable, progCounter, writer);
-                break;
-            case NodeType::Instruction:
-                status = EncodeInstruction(childNode, symTable, progCounter, writer);
-                break;
-            default:
-                break;
+        if (IsOrigDirective(childNode)) {
+            sections.push_back({ image.size(), childNode.token });
         }
-        if (!status) {
+        if (!encodeStatement(childNode, symTable, progCounter, image, image.size())) {
             encodeStatus = false;
         }
     }
-    return encodeStatus;
+    if (!encodeStatus || !SectionMap::finish(image, sections)) {
+        return false;
+    }
+    return writer.putProgram(image);
+}
+
+// Stores words into an in-memory image instead of a file.
+class ImageWriter {
+public:
+    ImageWriter(std::vector<LC3::Word>& image, size_t offset) :
+      m_image{ image },
+      m_offset{ offset }
+    {}
+
+    bool putWord(LC3::Word word) {
+        if (m_offset < m_image.size()) {
+            m_image[m_offset] = word;
+        } else {
+            m_image.push_back(word);
+        }
+        ++m_offset;
+
+        return true;
+    }
+
+private:
+    std::vector<LC3::Word>& m_image;
+    size_t m_offset;
+};
+
+size_t Encoder::statementSize(const SyntaxTreeNode& node) {
+    switch (node.type) {
+        case NodeType::Instruction:
+            return InstructionNode::size(node);
+        case NodeType::Directive: {
+            // The .ORIG directive occupies no memory, but it is emitted as
+            // the header of the section it starts.
+            Directive dirType = node.data<DirectiveNode>();
+
+            return dirType == Directive::ORIG ? SectionMap::HeaderSize : DirectiveNode::size(node);
+        }
+        default:
+            break;
+    }
+    return 0;
+}
+
+bool Encoder::isPcRelative(const SyntaxTreeNode& node) {
+    if (node.type != NodeType::Instruction) {
+        return false;
+    }
+    const auto& instrData = node.data<InstructionNode>();
+    const InstructionForm* form = InstructionForms::find(instrData.type, instrData.format);
+
+    return form != nullptr && form->isPcRelative();
+}
+
+namespace {
+
+struct Placement {
+    const SyntaxTreeNode* node = nullptr;
+    ProgramCounter progCounter;
+    size_t imageOffset = 0;
+};
+
+struct EncodeChunk {
+    size_t firstPlacement = 0;
+    size_t lastPlacement = 0;
+
+    Log::Context log;
+
+    bool status = true;
+};
+
+} // namespace
+
+bool Encoder::encode(const SyntaxTreeNode& rootNode, const SymbolTable& symTable,
+                     LC3Writer& writer, size_t maxThreads)
+{
+    assert(rootNode.type == NodeType::Root);
+
+    size_t numChunks = std::min(maxThreads, rootNode.children.size() / MinChunkStatements);
+
+    if (numChunks < 2) {
+        return encode(rootNode, symTable, writer);
+    }
+    std::vector<Placement> placements;
+    placements.reserve(rootNode.children.size());
+
+    ProgramCounter progCounter;
+    size_t imageSize = 0;
+    std::vector<SectionMap::Section> sections;
+
+    for (const SyntaxTreeNode& childNode : rootNode.children) {
+        progCounter.update(childNode);
+
+        if (IsOrigDirective(childNode)) {
+            sections.push_back({ imageSize, childNode.token });
+        }
+        size_t stmtSize = statementSize(childNode);
+
+        if (stmtSize > 0) {
+            placements.push_back({ &childNode, progCounter, imageSize });
+            imageSize += stmtSize;
+        }
+    }
+    std::vector<LC3::Word> image(imageSize);
+    std::vector<std::unique_ptr<EncodeChunk>> chunks;
+    size_t chunkLength = (placements.size() + numChunks - 1) / numChunks;
+
+    for (size_t first = 0; first < placements.size(); first += chunkLength) {
+        auto chunk = std::make_unique<EncodeChunk>();
+        chunk->firstPlacement = first;
+        chunk->lastPlacement = std::min(first + chunkLength, placements.size());
+
+        chunks.push_back(std::move(chunk));
+    }
+    {
+        const SourceFile* srcFile = SourceFile::active();
+        Util::ThreadPool pool{ chunks.size() };
+
+        for (auto& chunk : chunks) {
+            pool.submit([&, srcFile]() {
+                std::optional<SourceFile::Scope> srcScope;
+
+                if (srcFile != nullptr) {
+                    srcScope.emplace(*srcFile);
+                }
+                Log::Scope logScope{ chunk->log };
+
+                for (size_t i = chunk->firstPlacement; i < chunk->lastPlacement; ++i) {
+                    const Placement& placement = placements[i];
+                    ImageWriter imageWriter{ image, placement.imageOffset };
+
+                    if (!EncodeStatement(*placement.node, symTable,
+                                         placement.progCounter, imageWriter))
+                    {
+                        chunk->status = false;
+                    }
+                }
+            });
+        }
+    }
+    bool encodeStatus = true;
+
+    for (auto& chunk : chunks) {
+        Log::merge(chunk->log);
+
+        encodeStatus = encodeStatus && chunk->status;
+    }
+    if (!encodeStatus || !SectionMap::finish(image, sections)) {
+        return false;
+    }
+    return writer.putProgram(image);
+}
+
+bool Encoder::encodeStatement(const SyntaxTreeNode& node, const SymbolTable& symTable,
+                              const ProgramCounter& progCounter,
+                              std::vector<LC3::Word>& image, size_t imageOffset)
+{
+    assert(imageOffset <= image.size());
+
+    ImageWriter writer{ image, imageOffset };
+
+    return EncodeStatement(node, symTable, progCounter, writer);
 }
 
+template <typename WriterT>
+bool EncodeStatement(const SyntaxTreeNode& node, const SymbolTable& symTable,
+                     const ProgramCounter& progCounter, WriterT& writer)
+{
+    switch (node.type) {
+        case NodeType::Directive:
+            return EncodeDirective(node, symTable, progCounter, writer);
+        case NodeType::Instruction:
+            return EncodeInstruction(node, symTable, progCounter, writer);
+        default:
+            break;
+    }
+    return true;
+}
+
+template <typename WriterT>
 bool EncodeDirective(const SyntaxTreeNode& dirNode, const SymbolTable& symTable,
-                     const ProgramCounter& progCounter, LC3Writer& writer)
+                     const ProgramCounter& progCounter, WriterT& writer)
 {
     assert(dirNode.type == NodeType::Directive);
 
@@ -70,6 +262,8 @@ bool EncodeDirective(const SyntaxTreeNode& dirNode, const SymbolTable& symTable,
             LC3::Word startAddr = dirNode.child(0).data<NumberNode>();
 
             writer.putWord(startAddr);
+            // The section's length, filled in by SectionMap::finish().
+            writer.putWord(0);
             break;
         }
         case Directive::FILL: {
@@ -98,6 +292,9 @@ bool EncodeDirective(const SyntaxTreeNode& dirNode, const SymbolTable& symTable,
             break;
         }
         case Directive::END:
+        case Directive::EXTERNAL:
+        case Directive::GLOBAL:
+        case Directive::INCLUDE:
         case Directive::Invalid:
             break;
     }
@@ -118,7 +315,7 @@ static std::optional<LC3::Word> GetOffset(const SyntaxTreeNode& addrNode, const
     auto offsetVal = RestrictWidthSigned(rawOffset, bitWidth);
 
     if (!offsetVal) {
-        Log::error(addrNode) << "Offset cannot fit within " << bitWidth << " bits (" << rawOffset << ").\n";
+        Log::error(addrNode, Log::Code::Range) << "Offset cannot fit within " << bitWidth << " bits (" << rawOffset << ").\n";
 
         return {};
     }
@@ -138,111 +335,80 @@ static LC3::Word GetBranchFlags(const SyntaxTreeNode& flagsNode) {
     return LC3::Word(flagsVal);
 }
 
-static std::optional<LC3::Word> GetEncodedInstruction(const SyntaxTreeNode& instrNode,
-                                                      const SymbolTable& symTable,
-                                                      const ProgramCounter& progCounter)
+static std::optional<LC3::Word> GetEncodedOperand(const SyntaxTreeNode& operandNode,
+                                                  const OperandField& field,
+                                                  const SymbolTable& symTable,
+                                                  const ProgramCounter& progCounter)
 {
-    assert(instrNode.type == NodeType::Instruction);
-
-    const auto& instrData = instrNode.data<InstructionNode>();
-    LC3::Word opcode = Instructions::getOpcode(instrData.type);
-
-    switch (instrData.format) {
-        case NodeFormat::Empty:
-            return { opcode };
-        case NodeFormat::Vec: {
-            const auto& vecChild = instrNode.child(0);
-            auto rawVec = GetNodeValue(vecChild, symTable);
-            auto vecVal = RestrictWidth(rawVec, 8);
-
-            if (!vecVal) {
-                Log::error(vecChild) << "Vector is larger than 8 bits "
-                                        << "(" << rawVec << ").\n";
-                return { std::nullopt };
+    switch (field.kind) {
+        case OperandKind::Reg:
+            return { operandNode.data<RegisterNode>() };
+        case OperandKind::Flags:
+            return { GetBranchFlags(operandNode) };
+        case OperandKind::PcOffset:
+            return GetOffset(operandNode, symTable, progCounter, field.width);
+        case OperandKind::Imm:
+        case OperandKind::Offset: {
+            auto rawVal = GetNodeValue(operandNode, symTable);
+            auto val = RestrictWidthSigned(rawVal, field.width);
+
+            if (!val) {
+                Log::error(operandNode, Log::Code::Range) << (field.kind == OperandKind::Imm ? "Immediate" : "Offset")
+                                                          << " cannot fit within " << size_t{ field.width }
+                                                          << " bits (" << rawVal << ").\n";
             }
-            return { opcode | *vecVal };
+            return val;
         }
-        case NodeFormat::Addr: {
-            auto offsetVal = GetOffset(instrNode.child(0), symTable, progCounter, 11);
+        case OperandKind::Vector: {
+            auto rawVec = GetNodeValue(operandNode, symTable);
+            auto vecVal = RestrictWidth(rawVec, field.width);
 
-            if (!offsetVal) {
-                return { std::nullopt };
-            }
-            return { opcode | *offsetVal };
-        }
-        case NodeFormat::Branch: {
-            auto flagsVal = GetBranchFlags(instrNode.child(0));
-            auto offsetVal = GetOffset(instrNode.child(1), symTable, progCounter, 9);
-
-            if (!offsetVal) {
-                return { std::nullopt };
-            }
-            return { opcode | (flagsVal << 9) | *offsetVal };
-        }
-        case NodeFormat::RegReg: {
-            auto regOne = instrNode.child(0).data<RegisterNode>();
-            auto regTwo = instrNode.child(1).data<RegisterNode>();
-
-            return { opcode | (regOne << 9) | (regTwo << 6) };
-        }
-        case NodeFormat::RegAddr: {
-            auto regOne = instrNode.child(0).data<RegisterNode>();
-            auto& offsetChild = instrNode.child(1);
-            auto offsetVal = GetOffset(offsetChild, symTable, progCounter, 9);
-
-            if (!offsetVal) {
-                Log::error(offsetChild) << "Offset cannot fit within 9 bits.\n";
-
-                return { std::nullopt };
+            if (!vecVal) {
+                Log::error(operandNode, Log::Code::Range) << "Vector is larger than " << size_t{ field.width }
+                                                          << " bits (" << rawVec << ").\n";
             }
-            return { opcode | (regOne << 9) | *offsetVal };
+            return vecVal;
         }
-        case NodeFormat::RegRegReg: {
-            auto regOne = instrNode.child(0).data<RegisterNode>();
-            auto regTwo = instrNode.child(1).data<RegisterNode>();
-            auto regThree = instrNode.child(2).data<RegisterNode>();
+        case OperandKind::None:
+            break;
+    }
+    return { std::nullopt };
+}
 
-            return { opcode | (regOne << 9) | (regTwo << 6) | regThree };
-        }
-        case NodeFormat::RegRegNum: {
-            auto regOne = instrNode.child(0).data<RegisterNode>();
-            auto regTwo = instrNode.child(1).data<RegisterNode>();
+// Fills the operands into the form's fields, one child node each.
+static std::optional<LC3::Word> GetEncodedInstruction(const SyntaxTreeNode& instrNode,
+                                                      const SymbolTable& symTable,
+                                                      const ProgramCounter& progCounter)
+{
+    assert(instrNode.type == NodeType::Instruction);
 
-            auto& numChild = instrNode.child(2);
-            auto rawNum = GetNodeValue(numChild, symTable);
-            auto numVal = RestrictWidthSigned(rawNum, 5);
+    const auto& instrData = instrNode.data<InstructionNode>();
+    const InstructionForm* form = InstructionForms::find(instrData.type, instrData.format);
 
-            if (!numVal) {
-                Log::error(numChild) << "Imediate cannot fit within 5 bits.\n";
+    if (form == nullptr) {
+        Log::error(instrNode) << "Unimplemented instruction format " << instrData.format << "\n";
 
-                return { std::nullopt };
-            }
-            return { opcode | (regOne << 9) | (regTwo << 6) | (1 << 5) | *numVal };
-        }
-        case NodeFormat::RegRegAddr: {
-            auto regOne = instrNode.child(0).data<RegisterNode>();
-            auto regTwo = instrNode.child(1).data<RegisterNode>();
+        throw std::logic_error("Oops.");
+    }
+    LC3::Word encodedVal = form->bits;
+    size_t childIndex = 0;
 
-            auto& offsetChild = instrNode.child(2);
-            auto rawOffset = GetNodeValue(offsetChild, symTable);
-            auto offsetVal = RestrictWidthSigned(rawOffset, 6);
+    for (const OperandField& field : form->operands) {
+        if (field.kind == OperandKind::None) break;
 
-            if (!offsetVal) {
-                Log::error(offsetChild) << "Offset cannot fit within 6 bits.\n";
-                return { std::nullopt };
-            }
-            return { opcode | (regOne << 9) | (regTwo << 6) | *offsetVal };
+        auto operandVal = GetEncodedOperand(instrNode.child(childIndex++), field,
+                                            symTable, progCounter);
+        if (!operandVal) {
+            return { std::nullopt };
         }
-        default:
-            Log::error(instrNode) << "Unimplemented instruction format " << instrData.format << "\n";
-
-            throw std::logic_error("Oops.");
+        encodedVal = encodedVal | (*operandVal << field.shift);
     }
-    return { std::nullopt };
+    return { encodedVal };
 }
 
+template <typename WriterT>
 bool EncodeInstruction(const SyntaxTreeNode& instrNode, const SymbolTable& symTable,
-                       const ProgramCounter& progCounter, LC3Writer& writer)
+                       const ProgramCounter& progCounter, WriterT& writer)
 {
     assert(instrNode.type == NodeType::Instruction);
 
@@ -262,8 +428,7 @@ LC3::Word GetNodeValue(const SyntaxTreeNode& treeNode, const SymbolTable& symTab
     if (treeNode.type == NodeType::Number) {
         return treeNode.data<NumberNode>();
     }
-    StringView labelName = treeNode.token.str;
-    auto labelAddr = symTable.get(labelName);
+    auto labelAddr = symTable.get(treeNode.data<LabelRefNode>());
 
     assert(labelAddr.has_value());
 
@@ -273,10 +438,13 @@ LC3::Word GetNodeValue(const SyntaxTreeNode& treeNode, const SymbolTable& symTab
 static std::optional<LC3::Word> RestrictWidth_Helper(LC3::Word word, size_t numBits, bool isSigned) {
     assert(numBits <= LC3::Word::numBits);
 
-    LC3::WordValue maxValue = (1 << (numBits + 1)) - 1;
-    LC3::WordValue testValue = isSigned ? word.abs().value() : word.value();
+    // Signed fields hold -2^(n-1) up to 2^(n-1) - 1, unsigned ones up to
+    // 2^n - 1.
+    int32_t value = isSigned ? static_cast<int16_t>(word.value()) : word.value();
+    int32_t minValue = isSigned ? -(int32_t{ 1 } << (numBits - 1)) : 0;
+    int32_t maxValue = isSigned ? (int32_t{ 1 } << (numBits - 1)) - 1 : (int32_t{ 1 } << numBits) - 1;
 
-    if (testValue > maxValue) {
+    if (value < minValue || value > maxValue) {
         return std::nullopt;
     }
     LC3::WordValue bitMask = (1 << numBits) - 1;
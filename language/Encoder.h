@@ -1,15 +1,46 @@
 #pragma once
 
+#include <cstddef>
+#include <vector>
 #include <LC3Writer.h>
+#include <lc3/Word.h>
 #include "SymbolTable.h"
 #include "SyntaxTreeNode.h"
+#include "ProgramCounter.h"
 
 namespace LC3::Language {
 
 class Encoder {
 public:
+    // Programs with fewer statements than this per thread are never split.
+    static constexpr size_t MinChunkStatements = 1 << 14;
+
+    // Encodes the program and, if every statement encodes and none of its
+    // sections overlap, writes its image.
     static bool encode(const SyntaxTreeNode& root, const SymbolTable& symTable,
                        LC3Writer& writer);
+
+    // Produces the same words and diagnostics as encode(), using up to
+    // maxThreads threads. Every statement's offset into the output image is
+    // assigned up front from the sizes of those before it, so runs of
+    // statements can then be encoded concurrently into their own slices of
+    // one image. The image is only written once every statement encodes.
+    static bool encode(const SyntaxTreeNode& root, const SymbolTable& symTable,
+                       LC3Writer& writer, size_t maxThreads);
+
+    // Number of words a statement occupies in the output.
+    static size_t statementSize(const SyntaxTreeNode& node);
+
+    // Whether a statement's encoding depends on its own address, that is,
+    // whether it is an instruction with a PC-relative operand.
+    static bool isPcRelative(const SyntaxTreeNode& node);
+
+    // Encodes a single statement whose address has already been applied to
+    // progCounter. Its words are stored into image starting at imageOffset,
+    // overwriting existing words and appending past the end.
+    static bool encodeStatement(const SyntaxTreeNode& node, const SymbolTable& symTable,
+                                const ProgramCounter& progCounter,
+                                std::vector<LC3::Word>& image, size_t imageOffset);
 };
 
 } // namespace LC3::Language
@@ -24,8 +24,10 @@ struct Grammar : public ParserBase {
     using DirectiveStmt = TreeChild<DirectiveName, Many<DirectiveArg>>;
     using Directive = All<Period, DirectiveStmt>;
 
+    using Literal = All<LiteralSign, HaltIfNone<Number, LabelRef>>;
+
     template <template <typename... Ts> typename DisjuncType>
-    using InstrArg_T = TreeChild<DisjuncType<Register, Number, LabelRef>>;
+    using InstrArg_T = TreeChild<DisjuncType<Register, Number, Literal, LabelRef>>;
 
     using InstrArg_Head = InstrArg_T<Any>;
     using InstrArg_Tail = InstrArg_T<HaltIfNone>;
@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <util/MappedFile.h>
+#include "SourceFile.h"
+#include "Tokenizer.h"
+#include "IncludeCache.h"
+
+namespace LC3::Language {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct CachedFile : IncludeCache::File {
+    Util::MappedFile mapping;
+
+    // What the file looked like when it was loaded.
+    fs::file_time_type writeTime;
+    uintmax_t size = 0;
+
+    // Where its locations start, once it has been given some.
+    std::optional<uint32_t> baseOffset;
+
+    CachedFile() {}
+
+    CachedFile(const CachedFile& other) = delete;
+    CachedFile& operator = (const CachedFile& other) = delete;
+
+    ~CachedFile() {
+        if (baseOffset) {
+            SourceFile::removeIncluded(*baseOffset);
+        }
+    }
+};
+
+} // namespace
+
+// Keyed by canonical path, so that every spelling of a file's name shares
+// one entry. A file that changes after it was loaded is loaded again, and
+// the old entry lives on only as long as programs still hold its tokens.
+// The map is never destroyed, since unloading a file at exit would reach
+// into SourceFile's list of included files, which may be gone by then.
+static std::mutex s_cacheMutex;
+static auto& s_cache = *new std::unordered_map<std::string, std::shared_ptr<CachedFile>>;
+
+static std::shared_ptr<CachedFile> Load(const fs::path& path, const std::string& name,
+                                        fs::file_time_type writeTime, uintmax_t size)
+{
+    auto cached = std::make_shared<CachedFile>();
+    cached->path = path.string();
+    cached->mapping = Util::MappedFile{ cached->path };
+    cached->writeTime = writeTime;
+    cached->size = size;
+
+    if (!cached->mapping || cached->mapping.text().size() > SourceFile::MaxSize) {
+        return nullptr;
+    }
+    cached->baseOffset = SourceFile::addIncluded(name, cached->mapping.text());
+
+    if (!cached->baseOffset) {
+        return nullptr;
+    }
+    Tokenizer tokenizer{ cached->mapping.text(), *cached->baseOffset };
+
+    for (; tokenizer; ++tokenizer) {
+        cached->tokens.push_back(*tokenizer);
+    }
+    cached->tokens.push_back(*tokenizer);
+
+    return cached;
+}
+
+std::shared_ptr<const IncludeCache::File> IncludeCache::load(const std::string& path,
+                                                             const std::string& directory)
+{
+    fs::path filePath{ path };
+
+    if (filePath.is_relative() && !directory.empty()) {
+        filePath = fs::path{ directory } / filePath;
+    }
+    std::error_code ec;
+    fs::path canonicalPath = fs::canonical(filePath, ec);
+    fs::file_time_type writeTime = fs::last_write_time(canonicalPath, ec);
+    uintmax_t size = ec ? 0 : fs::file_size(canonicalPath, ec);
+
+    if (ec) {
+        return nullptr;
+    }
+    std::string key = canonicalPath.string();
+
+    // Loading under the lock keeps two threads from lexing the same file.
+    // It only happens once per file, so the wait is short-lived.
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+
+    auto iter = s_cache.find(key);
+
+    if (iter != s_cache.end() &&
+        (iter->second->writeTime != writeTime || iter->second->size != size))
+    {
+        s_cache.erase(iter);
+        iter = s_cache.end();
+    }
+    if (iter == s_cache.end()) {
+        auto cached = Load(canonicalPath, path, writeTime, size);
+
+        if (!cached) {
+            return nullptr;
+        }
+        iter = s_cache.emplace(std::move(key), std::move(cached)).first;
+    }
+    return iter->second;
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Token.h"
+
+namespace LC3::Language {
+
+// Loads the files named by .INCLUDE directives. Each file is mapped into
+// memory and lexed once per process, however many programs include it, so
+// a batch of submissions that all include the same library only pays for
+// parsing it, which has to intern its labels into each program's own
+// symbols. A file that has changed since it was loaded is loaded again.
+// The old copy is unloaded once the last program that included it lets go
+// of it, since its tokens point into the mapped text.
+class IncludeCache {
+public:
+    struct File {
+        // The canonical path the file was loaded from.
+        std::string path;
+
+        // Ends with an End token.
+        std::vector<Token> tokens;
+    };
+
+    // The file at path, or null if it cannot be read. A relative path is
+    // resolved against directory, or against the working directory if that
+    // is empty. Safe to call from any number of threads.
+    static std::shared_ptr<const File> load(const std::string& path,
+                                            const std::string& directory);
+};
+
+} // namespace LC3::Language
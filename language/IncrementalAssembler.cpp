@@ -0,0 +1,537 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <Log.h>
+#include "keywords/Directives.h"
+#include "TreeNodes.h"
+#include "SourceFile.h"
+#include "Parser.h"
+#include "Encoder.h"
+#include "SectionMap.h"
+#include "Assembler.h"
+#include "IncrementalAssembler.h"
+
+namespace LC3::Language {
+
+using Keywords::Directive;
+using Util::StringView;
+
+static std::vector<uint32_t> FindLineStarts(StringView text) {
+    std::vector<uint32_t> lineStarts{ 0 };
+    const char* textEnd = text.data() + text.size();
+
+    for (const char* pos = text.data(); pos != textEnd; ++pos) {
+        pos = static_cast<const char*>(std::memchr(pos, '\n', textEnd - pos));
+
+        if (pos == nullptr) break;
+
+        lineStarts.push_back(static_cast<uint32_t>(pos - text.data()) + 1);
+    }
+    return lineStarts;
+}
+
+static bool IsDirective(const SyntaxTreeNode& node, Directive dirType) {
+    return node.type == NodeType::Directive && node.data<DirectiveNode>() == dirType;
+}
+
+static bool IsStatement(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Instruction || node.type == NodeType::Directive;
+}
+
+// A string literal that spans lines would tie those lines together, which
+// the line-by-line bookkeeping cannot represent.
+static bool SpansLines(const SyntaxTreeNode& node) {
+    bool spansLines = false;
+
+    node.walk([&spansLines](const SyntaxTreeNode& child) {
+        if (child.type == NodeType::String) {
+            const StringView& str = child.token.str;
+
+            spansLines = spansLines || std::memchr(str.data(), '\n', str.size()) != nullptr;
+        }
+    });
+    return spansLines;
+}
+
+static void ShiftLocations(SyntaxTreeNode& node, int64_t delta) {
+    node.walk([delta](SyntaxTreeNode& child) {
+        child.token.location.offset = static_cast<uint32_t>(child.token.location.offset + delta);
+    });
+}
+
+const SyntaxTreeNode* IncrementalAssembler::Line::statement() const {
+    for (const SyntaxTreeNode& node : nodes) {
+        if (IsStatement(node)) {
+            return &node;
+        }
+    }
+    return nullptr;
+}
+
+bool IncrementalAssembler::distributeNodes(std::vector<SyntaxTreeNode>& nodes,
+                                           const std::vector<uint32_t>& lineStarts,
+                                           size_t firstLine, std::vector<Line>& lines)
+{
+    size_t lineIndex = firstLine;
+
+    for (SyntaxTreeNode& node : nodes) {
+        // Statements from an included file have no line in this one.
+        if (SpansLines(node) || node.location().offset >= SourceFile::IncludeOffset) {
+            return false;
+        }
+        uint32_t offset = node.location().offset;
+
+        while (lineIndex + 1 < lineStarts.size() && lineStarts[lineIndex + 1] <= offset) {
+            ++lineIndex;
+        }
+        assert(lineIndex - firstLine < lines.size());
+
+        lines[lineIndex - firstLine].nodes.push_back(std::move(node));
+    }
+    return true;
+}
+
+void IncrementalAssembler::reserveSymbol(SymbolId symbolId) {
+    if (symbolId >= m_defCounts.size()) {
+        m_defCounts.resize(symbolId + 1, 0);
+        m_refCounts.resize(symbolId + 1, 0);
+        m_symTable.grow(symbolId + 1);
+    }
+}
+
+bool IncrementalAssembler::update(std::string newText) {
+    m_texts.push_back(std::make_unique<std::string>(std::move(newText)));
+    m_wasIncremental = false;
+
+    SourceFile srcFile{ text() };
+    SourceFile::Scope srcScope{ srcFile };
+
+    bool updateStatus = updateText();
+
+    // A patched program includes nothing, or it could not have been patched.
+    m_includes = srcFile.includes();
+
+    return updateStatus;
+}
+
+bool IncrementalAssembler::updateText() {
+    if (m_isResident && m_canPatch && m_texts.size() <= MaxRetainedTexts) {
+        Log::Context droppedLog;
+        bool patchStatus = false;
+        {
+            Log::Scope droppedScope{ droppedLog };
+
+            patchStatus = patch();
+        }
+        if (patchStatus && droppedLog.errorCount() == 0 && droppedLog.warningCount() == 0) {
+            m_wasIncremental = true;
+
+            return true;
+        }
+    }
+    m_texts.erase(m_texts.begin(), m_texts.end() - 1);
+
+    return rebuild();
+}
+
+bool IncrementalAssembler::rebuild() {
+    m_isResident = false;
+
+    Log::Context droppedLog;
+    bool buildStatus = false;
+    {
+        Log::Scope droppedScope{ droppedLog };
+
+        buildStatus = build();
+    }
+    if (buildStatus && droppedLog.errorCount() == 0 && droppedLog.warningCount() == 0) {
+        m_isResident = true;
+
+        return true;
+    }
+    // Let an ordinary run of the assembler report the diagnostics. The
+    // resident program stays usable if they were only warnings.
+    bool assembleStatus = assembleFromScratch();
+
+    m_isResident = buildStatus && assembleStatus;
+
+    return assembleStatus;
+}
+
+bool IncrementalAssembler::assembleFromScratch() {
+    SymbolInterner symbols;
+    auto asTree = Parser::parse(text(), symbols);
+
+    if (!asTree) {
+        return false;
+    }
+    return Assembler::assemble(*asTree, symbols, m_image);
+}
+
+bool IncrementalAssembler::build() {
+    m_lineStarts = FindLineStarts(text());
+    m_lines.clear();
+    m_lines.resize(m_lineStarts.size());
+
+    m_symbols = SymbolInterner{};
+    m_symTable = SymbolTable{ m_symbols };
+    m_defCounts.clear();
+    m_refCounts.clear();
+    m_image.clear();
+    m_sectionLines.clear();
+
+    m_canPatch = false;
+
+    auto asTree = Parser::parse(text(), m_symbols);
+
+    if (!asTree || !distributeNodes(asTree->children, m_lineStarts, 0, m_lines)) {
+        return false;
+    }
+    // Checking, mirroring the Assembler's walk.
+    TreeAnalyzer analyzer;
+    bool seenOrig = false;
+    bool seenEnd = false;
+
+    m_endLine = m_lines.size();
+
+    for (size_t i = 0; i < m_lines.size(); ++i) {
+        for (SyntaxTreeNode& node : m_lines[i].nodes) {
+            if (!IsStatement(node)) continue;
+
+            if (!analyzer.analyzeStatement(node) || analyzer.terminated()) {
+                return false;
+            }
+            if (IsDirective(node, Directive::ORIG)) {
+                m_sectionLines.push_back(i);
+            }
+            if (!seenOrig && IsDirective(node, Directive::ORIG)) {
+                seenOrig = true;
+                m_origLine = i;
+                m_interiorAnalyzer = analyzer;
+            } else if (!seenEnd && IsDirective(node, Directive::END)) {
+                seenEnd = true;
+                m_endLine = i;
+            }
+        }
+    }
+    analyzer.finish();
+
+    // Labels and addresses.
+    ProgramCounter progCounter;
+    std::vector<SymbolId> pendingSyms;
+
+    for (Line& line : m_lines) {
+        for (const SyntaxTreeNode& node : line.nodes) {
+            if (node.type == NodeType::LabelDefn) {
+                SymbolId symbolId = node.data<LabelDefnNode>();
+
+                reserveSymbol(symbolId);
+
+                if (m_defCounts[symbolId]++ > 0) {
+                    return false;
+                }
+                pendingSyms.push_back(symbolId);
+
+                continue;
+            }
+            for (const SyntaxTreeNode& child : node.children) {
+                if (child.type == NodeType::LabelRef) {
+                    SymbolId symbolId = child.data<LabelRefNode>();
+
+                    reserveSymbol(symbolId);
+                    ++m_refCounts[symbolId];
+                }
+            }
+            progCounter.update(node);
+
+            if (IsDirective(node, Directive::END)) {
+                if (!pendingSyms.empty()) {
+                    return false;
+                }
+                continue;
+            }
+            for (SymbolId symbolId : pendingSyms) {
+                m_symTable.add(symbolId, progCounter.address());
+            }
+            pendingSyms.clear();
+        }
+        line.progCounter = progCounter;
+    }
+    if (!pendingSyms.empty()) {
+        return false;
+    }
+    for (SymbolId symbolId = 0; symbolId < m_refCounts.size(); ++symbolId) {
+        if (m_refCounts[symbolId] > 0 && m_defCounts[symbolId] == 0) {
+            return false;
+        }
+    }
+    // Encoding.
+    for (Line& line : m_lines) {
+        const SyntaxTreeNode* stmt = line.statement();
+
+        line.imageOffset = m_image.size();
+        line.size = stmt != nullptr ? Encoder::statementSize(*stmt) : 0;
+
+        if (stmt == nullptr) continue;
+
+        if (!Encoder::encodeStatement(*stmt, m_symTable, line.progCounter,
+                                      m_image, line.imageOffset))
+        {
+            return false;
+        }
+        m_image.resize(line.imageOffset + line.size);
+    }
+    if (!finishSections()) {
+        return false;
+    }
+    m_canPatch = seenOrig;
+
+    return true;
+}
+
+bool IncrementalAssembler::patch() {
+    StringView oldText = *m_texts[m_texts.size() - 2];
+    StringView newText = text();
+
+    const std::vector<uint32_t>& oldStarts = m_lineStarts;
+    std::vector<uint32_t> newStarts = FindLineStarts(newText);
+
+    // Lines [0, prefix) are the same in both texts, as are the last suffix
+    // lines of each. The lines between them are what changed.
+    size_t commonLen = std::min(oldText.size(), newText.size());
+    size_t firstDiff = static_cast<size_t>(
+        std::mismatch(oldText.data(), oldText.data() + commonLen, newText.data()).first -
+        oldText.data());
+
+    if (firstDiff == commonLen && oldText.size() == newText.size()) {
+        return true;
+    }
+    size_t prefix = static_cast<size_t>(
+        std::upper_bound(oldStarts.begin(), oldStarts.end(), firstDiff) - oldStarts.begin()) - 1;
+
+    size_t maxTail = commonLen - oldStarts[prefix];
+    size_t tailLen = 0;
+
+    while (tailLen < maxTail &&
+           oldText[oldText.size() - 1 - tailLen] == newText[newText.size() - 1 - tailLen])
+    {
+        ++tailLen;
+    }
+    // A trailing line is only shared if the linebreak before it is too.
+    size_t suffix = static_cast<size_t>(
+        oldStarts.end() -
+        std::upper_bound(oldStarts.begin(), oldStarts.end(), oldText.size() - tailLen));
+
+    size_t oldEnd = oldStarts.size() - suffix;
+    size_t newEnd = newStarts.size() - suffix;
+
+    if (prefix <= m_origLine || oldEnd > m_endLine) {
+        return false;
+    }
+    // Parse the changed lines.
+    std::vector<Line> newLines(newEnd - prefix);
+
+    if (newEnd > prefix) {
+        uint32_t sliceStart = newStarts[prefix];
+        uint32_t sliceEnd = newEnd < newStarts.size() ?
+                            newStarts[newEnd] :
+                            static_cast<uint32_t>(newText.size());
+
+        auto slice = Parser::parseSlice(newText.subString(sliceStart, sliceEnd - sliceStart),
+                                        sliceStart, m_symbols);
+
+        if (!slice || !distributeNodes(slice->children, newStarts, prefix, newLines)) {
+            return false;
+        }
+    }
+    TreeAnalyzer analyzer = m_interiorAnalyzer;
+
+    for (Line& line : newLines) {
+        for (SyntaxTreeNode& node : line.nodes) {
+            if (!IsStatement(node)) continue;
+
+            if (IsDirective(node, Directive::ORIG) || IsDirective(node, Directive::END) ||
+                !analyzer.analyzeStatement(node))
+            {
+                return false;
+            }
+        }
+        const SyntaxTreeNode* stmt = line.statement();
+        line.size = stmt != nullptr ? Encoder::statementSize(*stmt) : 0;
+    }
+    // Update symbol use counts, then check the symbols that were touched.
+    std::vector<SymbolId> touchedSyms;
+
+    auto countSymbols = [this, &touchedSyms](const Line& line, int delta) {
+        for (const SyntaxTreeNode& node : line.nodes) {
+            if (node.type == NodeType::LabelDefn) {
+                SymbolId symbolId = node.data<LabelDefnNode>();
+
+                reserveSymbol(symbolId);
+                m_defCounts[symbolId] += delta;
+                touchedSyms.push_back(symbolId);
+
+                continue;
+            }
+            for (const SyntaxTreeNode& child : node.children) {
+                if (child.type == NodeType::LabelRef) {
+                    SymbolId symbolId = child.data<LabelRefNode>();
+
+                    reserveSymbol(symbolId);
+                    m_refCounts[symbolId] += delta;
+                    touchedSyms.push_back(symbolId);
+                }
+            }
+        }
+    };
+    size_t oldRegionSize = 0;
+    size_t newRegionSize = 0;
+
+    for (size_t i = prefix; i < oldEnd; ++i) {
+        countSymbols(m_lines[i], -1);
+        oldRegionSize += m_lines[i].size;
+    }
+    for (const Line& line : newLines) {
+        countSymbols(line, 1);
+        newRegionSize += line.size;
+    }
+    for (SymbolId symbolId : touchedSyms) {
+        if (m_defCounts[symbolId] > 1 ||
+            (m_refCounts[symbolId] > 0 && m_defCounts[symbolId] == 0))
+        {
+            return false;
+        }
+    }
+    // Splice the new lines in. Lines after the edit keep their nodes, whose
+    // locations move by however much the text before them grew or shrank.
+    size_t imageStart = prefix < m_lines.size() ? m_lines[prefix].imageOffset : m_image.size();
+
+    if (suffix > 0) {
+        int64_t delta = static_cast<int64_t>(newStarts[newEnd]) - oldStarts[oldEnd];
+
+        if (delta != 0) {
+            for (size_t i = oldEnd; i < m_lines.size(); ++i) {
+                for (SyntaxTreeNode& node : m_lines[i].nodes) {
+                    ShiftLocations(node, delta);
+                }
+            }
+        }
+    }
+    m_lines.erase(m_lines.begin() + prefix, m_lines.begin() + oldEnd);
+    m_lines.insert(m_lines.begin() + prefix,
+                   std::make_move_iterator(newLines.begin()),
+                   std::make_move_iterator(newLines.end()));
+    m_lineStarts = std::move(newStarts);
+    m_endLine = m_endLine - oldEnd + newEnd;
+
+    for (size_t& lineIndex : m_sectionLines) {
+        if (lineIndex >= oldEnd) {
+            lineIndex = lineIndex - oldEnd + newEnd;
+        }
+    }
+
+    m_image.erase(m_image.begin() + imageStart, m_image.begin() + imageStart + oldRegionSize);
+    m_image.insert(m_image.begin() + imageStart, newRegionSize, LC3::Word(0));
+
+    // Reassign addresses from the edit on. If its size did not change, the
+    // addresses after it stay put, and only labels still waiting for a
+    // statement need to be followed past it.
+    bool sizeChanged = newRegionSize != oldRegionSize;
+    ProgramCounter progCounter = m_lines[prefix - 1].progCounter;
+    size_t imageOffset = imageStart;
+
+    std::vector<SymbolId> pendingSyms;
+    std::vector<bool> movedSyms(m_defCounts.size(), false);
+    bool anyMoved = false;
+
+    // Labels on lines of their own just before the edit are still waiting
+    // for the statement that gives them their address.
+    for (size_t i = prefix; i-- > 0 && m_lines[i].statement() == nullptr;) {
+        for (const SyntaxTreeNode& node : m_lines[i].nodes) {
+            pendingSyms.push_back(node.data<LabelDefnNode>());
+        }
+    }
+
+    for (size_t i = prefix; i < m_lines.size(); ++i) {
+        if (i >= newEnd && pendingSyms.empty() && !sizeChanged) break;
+
+        Line& line = m_lines[i];
+
+        for (const SyntaxTreeNode& node : line.nodes) {
+            if (node.type == NodeType::LabelDefn) {
+                pendingSyms.push_back(node.data<LabelDefnNode>());
+
+                continue;
+            }
+            progCounter.update(node);
+
+            if (IsDirective(node, Directive::END)) {
+                if (!pendingSyms.empty()) {
+                    return false;
+                }
+                continue;
+            }
+            for (SymbolId symbolId : pendingSyms) {
+                auto oldAddress = m_symTable.get(symbolId);
+
+                if (!oldAddress || oldAddress->value() != progCounter.address().value()) {
+                    m_symTable.add(symbolId, progCounter.address());
+                    movedSyms[symbolId] = true;
+                    anyMoved = true;
+                }
+            }
+            pendingSyms.clear();
+        }
+        line.progCounter = progCounter;
+        line.imageOffset = imageOffset;
+        imageOffset += line.size;
+    }
+    if (!pendingSyms.empty()) {
+        return false;
+    }
+    // Encode what the edit affected.
+    size_t scanStart = anyMoved ? 0 : prefix;
+    size_t scanEnd = anyMoved || sizeChanged ? m_lines.size() : newEnd;
+
+    for (size_t i = scanStart; i < scanEnd; ++i) {
+        const Line& line = m_lines[i];
+        const SyntaxTreeNode* stmt = line.statement();
+
+        if (stmt == nullptr) continue;
+
+        bool isEdited = i >= prefix && i < newEnd;
+        bool hasMoved = sizeChanged && i >= newEnd && Encoder::isPcRelative(*stmt);
+        bool refsMoved = false;
+
+        for (const SyntaxTreeNode& child : stmt->children) {
+            if (anyMoved && child.type == NodeType::LabelRef) {
+                refsMoved = refsMoved || movedSyms[child.data<LabelRefNode>()];
+            }
+        }
+        if (!isEdited && !hasMoved && !refsMoved) continue;
+
+        if (!Encoder::encodeStatement(*stmt, m_symTable, line.progCounter,
+                                      m_image, line.imageOffset))
+        {
+            return false;
+        }
+    }
+    // The edited section's length changed, and it may now run into the
+    // sections after it.
+    return !sizeChanged || finishSections();
+}
+
+bool IncrementalAssembler::finishSections() {
+    std::vector<SectionMap::Section> sections;
+
+    for (size_t lineIndex : m_sectionLines) {
+        const Line& line = m_lines[lineIndex];
+
+        sections.push_back({ line.imageOffset, line.statement()->token });
+    }
+    return SectionMap::finish(m_image, sections);
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <lc3/Word.h>
+#include <util/StringView.h>
+#include "SymbolInterner.h"
+#include "SymbolTable.h"
+#include "SyntaxTreeNode.h"
+#include "TreeAnalyzer.h"
+#include "ProgramCounter.h"
+
+namespace LC3::Language {
+
+// Keeps an assembled program resident so that an edited version of its
+// source can be reassembled by redoing only the work the edit affects.
+//
+// The changed lines are found by matching the leading and trailing text the
+// old and new source have in common, and only those lines are lexed and
+// parsed again. Addresses are reassigned from the edit onward only if it
+// changed the program's size. The only statements encoded again are the
+// edited ones, PC-relative ones whose address moved, and ones that refer
+// to a label whose address moved.
+//
+// An edit outside the first section, one that touches .ORIG or .END, a
+// string literal spanning lines, or a change that produces any diagnostic
+// falls back to assembling from scratch, which reports exactly what a
+// normal run would. So does every edit to a program that includes other
+// files.
+class IncrementalAssembler {
+public:
+    // Statements that survive an edit keep pointing into the text they were
+    // parsed from, so every edited text is kept alive. After this many, the
+    // program is reassembled from scratch to release them.
+    static constexpr size_t MaxRetainedTexts = 64;
+
+    IncrementalAssembler() {}
+
+    IncrementalAssembler(const IncrementalAssembler& other) = delete;
+    IncrementalAssembler& operator = (const IncrementalAssembler& other) = delete;
+
+    // Brings the program up to date with text. Returns false if the program
+    // has errors, which are reported through Log.
+    bool update(std::string text);
+
+    // The program as of the last successful update, in output order.
+    const std::vector<LC3::Word>& image() const {
+        return m_image;
+    }
+
+    // Whether the last update reused the resident program.
+    bool wasIncremental() const {
+        return m_wasIncremental;
+    }
+
+    // The canonical paths of the files the text of the last update
+    // included, directly or not.
+    const std::vector<std::string>& includes() const {
+        return m_includes;
+    }
+
+private:
+    struct Line {
+        // The top-level nodes that start on this line: at most one label
+        // and one statement.
+        std::vector<SyntaxTreeNode> nodes;
+
+        // The program counter after this line's statement.
+        ProgramCounter progCounter;
+
+        size_t imageOffset = 0;
+        size_t size = 0;
+
+        const SyntaxTreeNode* statement() const;
+    };
+
+    // Files each node under the line it starts on. lines[0] is the line
+    // with index firstLine.
+    static bool distributeNodes(std::vector<SyntaxTreeNode>& nodes,
+                                const std::vector<uint32_t>& lineStarts,
+                                size_t firstLine, std::vector<Line>& lines);
+
+    bool updateText();
+    bool patch();
+    bool rebuild();
+    bool build();
+    bool assembleFromScratch();
+    bool finishSections();
+
+    void reserveSymbol(SymbolId symbolId);
+
+    Util::StringView text() const {
+        return *m_texts.back();
+    }
+
+    std::vector<std::unique_ptr<std::string>> m_texts;
+    std::vector<uint32_t> m_lineStarts;
+    std::vector<Line> m_lines;
+
+    SymbolInterner m_symbols;
+    SymbolTable m_symTable{ m_symbols };
+    std::vector<uint32_t> m_defCounts;
+    std::vector<uint32_t> m_refCounts;
+
+    // The analyzer's state between the first .ORIG and .END, where every
+    // edit that can be patched in lies.
+    TreeAnalyzer m_interiorAnalyzer;
+    size_t m_origLine = 0;
+    size_t m_endLine = 0;
+
+    // The lines of every .ORIG, which start the program's sections.
+    std::vector<size_t> m_sectionLines;
+
+    std::vector<LC3::Word> m_image;
+    std::vector<std::string> m_includes;
+
+    bool m_isResident = false;
+    bool m_canPatch = false;
+    bool m_wasIncremental = false;
+};
+
+} // namespace LC3::Language
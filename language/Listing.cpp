@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <util/TextWriter.h>
+#include "SourceFile.h"
+#include "Listing.h"
+
+namespace LC3::Language {
+
+using Util::TextWriter;
+
+static void PutNumber(TextWriter& writer, LC3::Word word) {
+    writer.put('x');
+    writer.putHex(word.value(), 4);
+}
+
+bool Listing::writeListing(const char* fileName, const std::vector<LC3::Word>& image,
+                           const std::vector<Assembler::Placement>& placements)
+{
+    TextWriter writer{ fileName };
+
+    for (const Assembler::Placement& placement : placements) {
+        auto pos = SourceFile::find(placement.location);
+        StringView line = pos ? pos->line : StringView{};
+
+        PutNumber(writer, placement.address);
+
+        if (placement.numWords == 0) {
+            writer.put("        "_sv);
+            writer.put(line);
+            writer.put('\n');
+
+            continue;
+        }
+        for (uint32_t i = 0; i < placement.numWords; ++i) {
+            if (i > 0) {
+                PutNumber(writer, placement.address + LC3::Word(static_cast<LC3::WordValue>(i)));
+            }
+            writer.put(' ');
+            PutNumber(writer, image[placement.imageOffset + i]);
+
+            if (i == 0) {
+                writer.put("  "_sv);
+                writer.put(line);
+            }
+            writer.put('\n');
+        }
+    }
+    return writer.close();
+}
+
+bool Listing::writeSymbols(const char* fileName, const SymbolTable& symTable) {
+    std::vector<std::pair<uint16_t, SymbolId>> labels;
+
+    for (SymbolId symbolId = 0; symbolId < symTable.size(); ++symbolId) {
+        if (auto addr = symTable.get(symbolId)) {
+            labels.emplace_back(addr->value(), symbolId);
+        }
+    }
+    std::sort(labels.begin(), labels.end());
+
+    TextWriter writer{ fileName };
+
+    for (const auto& [addr, symbolId] : labels) {
+        PutNumber(writer, addr);
+        writer.put(' ');
+        writer.put(symTable.name(symbolId));
+        writer.put('\n');
+    }
+    return writer.close();
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <lc3/Word.h>
+#include "Assembler.h"
+#include "SymbolTable.h"
+
+namespace LC3::Language {
+
+// Writes the text maps that debuggers and profilers read alongside an
+// assembled program.
+//
+// A listing has a line for each word of the program: its address, its
+// value and, on the first word of a statement, the source line the
+// statement is on. An .ORIG gets a line of its own, with no value. A
+// symbol map has a line for each label, giving its address, ordered by
+// address. Numbers are in hexadecimal with an x prefix, as in the source.
+class Listing {
+public:
+    // Locations are resolved against the active source file, so it must be
+    // the one the program was assembled from.
+    static bool writeListing(const char* fileName, const std::vector<LC3::Word>& image,
+                             const std::vector<Assembler::Placement>& placements);
+
+    static bool writeSymbols(const char* fileName, const SymbolTable& symTable);
+};
+
+} // namespace LC3::Language
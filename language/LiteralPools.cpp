@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include <lc3/Word.h>
+#include <Log.h>
+#include "keywords/Directives.h"
+#include "keywords/InstructionForms.h"
+#include "TreeNodes.h"
+#include "LiteralPools.h"
+
+namespace LC3::Language {
+
+using Keywords::Directive;
+using Keywords::Instruction;
+using Keywords::InstructionForm;
+using Keywords::InstructionForms;
+using Keywords::OperandKind;
+
+namespace {
+
+struct Statement {
+    size_t nodeIndex = 0;
+    size_t size = 0;
+
+    // Where the statement was before any pool, and where it ends up.
+    LC3::WordValue oldAddress = 0;
+    LC3::WordValue address = 0;
+};
+
+// Loads of the same number, or of the same label, share an entry.
+using LiteralKey = std::pair<NodeType, uint32_t>;
+
+struct PendingLiteral {
+    LiteralKey key;
+    std::vector<size_t> loads;
+};
+
+struct PoolEntry {
+    size_t afterStmt = 0;
+    SyntaxTreeNode node;
+};
+
+// The TRAP vector HALT stands for.
+constexpr LC3::WordValue HaltVector = 0x25;
+
+} // namespace
+
+static bool IsLiteralLoad(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Instruction && node.children.size() == 2 &&
+           node.child(1).type == NodeType::Literal;
+}
+
+static LiteralKey GetKey(const SyntaxTreeNode& literal) {
+    const SyntaxTreeNode& value = literal.child(0);
+
+    if (value.type == NodeType::LabelRef) {
+        return { NodeType::LabelRef, value.data<LabelRefNode>() };
+    }
+    return { NodeType::Number, value.data<NumberNode>().value() };
+}
+
+// Whether control never falls through to whatever follows a statement.
+static bool IsUnconditional(const SyntaxTreeNode& node) {
+    if (node.type != NodeType::Instruction) {
+        return false;
+    }
+    switch (node.data<InstructionNode>().type) {
+        case Instruction::BR: {
+            const auto& flags = node.child(0).data<BRFlagsNode>();
+
+            return flags.n && flags.z && flags.p;
+        }
+        case Instruction::TRAP:
+            return node.child(0).data<NumberNode>().value() == HaltVector;
+        case Instruction::JMP:
+        case Instruction::RET:
+        case Instruction::RTI:
+        case Instruction::HALT:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+static bool IsDirective(const SyntaxTreeNode& node, Directive dirType) {
+    return node.type == NodeType::Directive && node.data<DirectiveNode>() == dirType;
+}
+
+static size_t GetSize(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Instruction ? InstructionNode::size(node) : DirectiveNode::size(node);
+}
+
+static bool Reaches(LC3::WordValue loadAddr, LC3::WordValue entryAddr) {
+    int32_t offset = static_cast<int32_t>(entryAddr) - (static_cast<int32_t>(loadAddr) + 1);
+
+    return offset >= -256 && offset <= 255;
+}
+
+static void ReportUnplaced(const std::vector<PendingLiteral>& pending,
+                           const std::vector<Statement>& stmts, const SyntaxTreeNode& root)
+{
+    for (const PendingLiteral& literal : pending) {
+        for (size_t load : literal.loads) {
+            Log::error(root.children[stmts[load].nodeIndex].child(1), Log::Code::Range)
+                << "No literal pool within reach. Pools go after BRnzp, JMP, RET, RTI "
+                << "and HALT instructions, so one has to follow within 255 words.\n";
+        }
+    }
+}
+
+// Moves numeric addresses of PC-relative operands along with the statement
+// they point at, as long as it is in the same section.
+static void MoveNumericAddresses(SyntaxTreeNode& root, const std::vector<Statement>& stmts,
+                                 size_t first, size_t last)
+{
+    // Pools only ever add to how far statements move.
+    if (stmts[last - 1].address == stmts[last - 1].oldAddress) {
+        return;
+    }
+    LC3::WordValue sectionStart = stmts[first].oldAddress;
+    LC3::WordValue sectionEnd = static_cast<LC3::WordValue>(stmts[last - 1].oldAddress +
+                                                            stmts[last - 1].size);
+
+    for (size_t i = first; i < last; ++i) {
+        SyntaxTreeNode& node = root.children[stmts[i].nodeIndex];
+
+        if (node.type != NodeType::Instruction) continue;
+
+        const auto& instrData = node.data<InstructionNode>();
+        const InstructionForm* form = InstructionForms::find(instrData.type, instrData.format);
+
+        for (size_t j = 0; form != nullptr && j < node.children.size(); ++j) {
+            if (form->operands[j].kind != OperandKind::PcOffset ||
+                node.child(j).type != NodeType::Number)
+            {
+                continue;
+            }
+            LC3::Word& target = node.child(j).data<NumberNode>();
+            LC3::WordValue targetAddr = target.value();
+
+            if (targetAddr < sectionStart || targetAddr > sectionEnd) continue;
+
+            // The last statement that starts at or before the target.
+            auto stmt = std::upper_bound(stmts.begin() + first, stmts.begin() + last, targetAddr,
+                                         [](LC3::WordValue addr, const Statement& other) {
+                                             return addr < other.oldAddress;
+                                         }) - 1;
+
+            target = LC3::Word(static_cast<LC3::WordValue>(targetAddr + stmt->address -
+                                                           stmt->oldAddress));
+        }
+    }
+}
+
+bool LiteralPools::used(const SyntaxTreeNode& root) {
+    assert(root.type == NodeType::Root);
+
+    return std::any_of(root.children.begin(), root.children.end(), IsLiteralLoad);
+}
+
+bool LiteralPools::place(SyntaxTreeNode& root) {
+    assert(root.type == NodeType::Root);
+
+    std::vector<Statement> stmts;
+
+    for (size_t i = 0; i < root.children.size(); ++i) {
+        const SyntaxTreeNode& node = root.children[i];
+
+        if (node.type == NodeType::Instruction || node.type == NodeType::Directive) {
+            stmts.push_back({ i, GetSize(node) });
+        }
+    }
+    std::vector<PoolEntry> entries;
+    std::vector<std::pair<size_t, LC3::WordValue>> loadTargets;
+    std::vector<PendingLiteral> pending;
+    std::map<LiteralKey, size_t> pendingIndex;
+
+    // The latest entry for each constant in the current section.
+    std::map<LiteralKey, LC3::WordValue> placed;
+
+    // Where each section starts in stmts.
+    std::vector<size_t> sectionStarts;
+
+    LC3::WordValue oldAddr = 0;
+    LC3::WordValue shift = 0;
+    bool status = true;
+
+    for (size_t i = 0; i < stmts.size(); ++i) {
+        SyntaxTreeNode& node = root.children[stmts[i].nodeIndex];
+
+        if (IsDirective(node, Directive::ORIG)) {
+            ReportUnplaced(pending, stmts, root);
+            status = status && pending.empty();
+
+            pending.clear();
+            pendingIndex.clear();
+            placed.clear();
+            sectionStarts.push_back(i);
+
+            oldAddr = node.child(0).data<NumberNode>().value();
+            shift = 0;
+        }
+        stmts[i].oldAddress = oldAddr;
+        stmts[i].address = static_cast<LC3::WordValue>(oldAddr + shift);
+        oldAddr = static_cast<LC3::WordValue>(oldAddr + stmts[i].size);
+
+        if (IsLiteralLoad(node)) {
+            LiteralKey key = GetKey(node.child(1));
+            auto entry = placed.find(key);
+
+            if (entry != placed.end() && Reaches(stmts[i].address, entry->second)) {
+                loadTargets.push_back({ i, entry->second });
+            } else {
+                auto [index, inserted] = pendingIndex.try_emplace(key, pending.size());
+
+                if (inserted) {
+                    pending.push_back({ key, {} });
+                }
+                pending[index->second].loads.push_back(i);
+            }
+        }
+        if (!IsUnconditional(node) || pending.empty()) continue;
+
+        auto entryAddr = static_cast<LC3::WordValue>(stmts[i].address + stmts[i].size);
+
+        for (PendingLiteral& literal : pending) {
+            for (size_t load : literal.loads) {
+                if (!Reaches(stmts[load].address, entryAddr)) {
+                    Log::error(root.children[stmts[load].nodeIndex].child(1), Log::Code::Range)
+                        << "Literal pool is out of reach. Pools go after BRnzp, JMP, RET, RTI "
+                        << "and HALT instructions, so one has to follow within 255 words.\n";
+                    status = false;
+                }
+                loadTargets.push_back({ load, entryAddr });
+            }
+            SyntaxTreeNode& value = root.children[stmts[literal.loads.front()].nodeIndex].child(1);
+            SyntaxTreeNode fill = DirectiveNode{ Directive::FILL, value.token };
+
+            fill.children.push_back(std::move(value.child(0)));
+            entries.push_back({ i, std::move(fill) });
+
+            placed[literal.key] = entryAddr;
+            entryAddr = static_cast<LC3::WordValue>(entryAddr + 1);
+        }
+        shift = static_cast<LC3::WordValue>(shift + pending.size());
+
+        pending.clear();
+        pendingIndex.clear();
+    }
+    ReportUnplaced(pending, stmts, root);
+
+    if (!status || !pending.empty()) {
+        return false;
+    }
+    sectionStarts.push_back(stmts.size());
+
+    for (size_t i = 0; i + 1 < sectionStarts.size(); ++i) {
+        MoveNumericAddresses(root, stmts, sectionStarts[i], sectionStarts[i + 1]);
+    }
+    for (const auto& [load, entryAddr] : loadTargets) {
+        SyntaxTreeNode& literal = root.children[stmts[load].nodeIndex].child(1);
+
+        literal = NumberNode{ LC3::Word(entryAddr), literal.token };
+    }
+    std::vector<SyntaxTreeNode> children;
+    children.reserve(root.children.size() + entries.size());
+
+    auto stmt = stmts.begin();
+    auto entry = entries.begin();
+
+    for (size_t i = 0; i < root.children.size(); ++i) {
+        children.push_back(std::move(root.children[i]));
+
+        if (stmt == stmts.end() || stmt->nodeIndex != i) continue;
+
+        size_t stmtIndex = static_cast<size_t>(stmt - stmts.begin());
+        ++stmt;
+
+        for (; entry != entries.end() && entry->afterStmt == stmtIndex; ++entry) {
+            children.push_back(std::move(entry->node));
+        }
+    }
+    root.children = std::move(children);
+
+    return true;
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "SyntaxTreeNode.h"
+
+namespace LC3::Language {
+
+// Places the constants that LD R, =value and LD R, =LABEL load into literal
+// pools: runs of .FILL directives right after the BRnzp, JMP, RET, RTI and
+// HALT instructions of a section, which control never falls out of.
+//
+// A literal goes in the first pool after its load, unless a pool before it
+// already holds the same constant within reach, so each pool holds what was
+// loaded since the one before it, once. The loads are then pointed at the
+// addresses of their literals.
+//
+// Pools move the statements after them, so this runs after every other
+// pass that lays the program out but relaxing, which has to run again after
+// it in case a pool puts a branch out of reach. The symbol table has to be
+// made again afterwards. A numeric address of a PC-relative operand that falls within
+// its own section keeps pointing at the same statement.
+class LiteralPools {
+public:
+    // Whether any instruction loads a literal.
+    static bool used(const SyntaxTreeNode& root);
+
+    // Returns false if a load has no pool within reach. root must have been
+    // analyzed with literals allowed.
+    static bool place(SyntaxTreeNode& root);
+};
+
+} // namespace LC3::Language
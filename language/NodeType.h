@@ -13,6 +13,7 @@ enum class NodeType {
     Register,
     Number,
     String,
+    Literal,
     Blank,
     Root
 };
@@ -32,6 +33,7 @@ inline std::ostream& operator << (std::ostream& outStream, NodeType nodeType) {
         CASE(Register);
         CASE(Number);
         CASE(String);
+        CASE(Literal);
         CASE(Blank);
         CASE(Root);
 
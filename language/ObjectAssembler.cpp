@@ -0,0 +1,286 @@
+#include <cassert>
+#include <optional>
+#include <string>
+#include <vector>
+#include <Log.h>
+#include "keywords/Directives.h"
+#include "TreeNodes.h"
+#include "TreeAnalyzer.h"
+#include "SymbolTable.h"
+#include "ProgramCounter.h"
+#include "Encoder.h"
+#include "ObjectAssembler.h"
+
+namespace LC3::Language {
+
+using Keywords::Directive;
+using RelocationType = ObjectFile::RelocationType;
+using Binding = ObjectFile::Binding;
+
+namespace {
+
+struct SymbolInfo {
+    bool isDefined = false;
+    bool isExternal = false;
+    bool isExported = false;
+
+    size_t section = 0;
+    LC3::WordValue offset = 0;
+
+    // Index into the object's symbol list, once it has been given one.
+    std::optional<uint32_t> objectIndex;
+};
+
+} // namespace
+
+static bool IsDeclaration(const SyntaxTreeNode& node) {
+    if (node.type != NodeType::Directive) {
+        return false;
+    }
+    Directive dirType = node.data<DirectiveNode>();
+
+    return dirType == Directive::EXTERNAL || dirType == Directive::GLOBAL;
+}
+
+static const SyntaxTreeNode* FindLabelRef(const SyntaxTreeNode& node) {
+    for (const SyntaxTreeNode& child : node.children) {
+        if (child.type == NodeType::LabelRef) {
+            return &child;
+        }
+    }
+    return nullptr;
+}
+
+// The kind of field a statement's label operand is encoded into.
+static RelocationType GetFieldType(const SyntaxTreeNode& node) {
+    if (node.type == NodeType::Instruction) {
+        switch (node.data<InstructionNode>().format) {
+            case NodeFormat::Addr:
+                return RelocationType::PcOffset11;
+            case NodeFormat::Branch:
+            case NodeFormat::RegAddr:
+                return RelocationType::PcOffset9;
+            case NodeFormat::RegRegAddr:
+                return RelocationType::Offset6;
+            default:
+                break;
+        }
+    }
+    return RelocationType::Word;
+}
+
+static bool IsPcRelative(RelocationType type) {
+    return type == RelocationType::PcOffset11 || type == RelocationType::PcOffset9;
+}
+
+static bool CollectSymbols(const SyntaxTreeNode& root, std::vector<SymbolInfo>& symInfo) {
+    bool status = true;
+
+    for (const SyntaxTreeNode& node : root.children) {
+        if (node.type != NodeType::LabelDefn) continue;
+
+        SymbolInfo& info = symInfo[node.data<LabelDefnNode>()];
+
+        if (info.isDefined) {
+            Log::error(node, Log::Code::Symbol) << "Symbol has multiple definitions.\n";
+            status = false;
+        }
+        info.isDefined = true;
+    }
+    for (const SyntaxTreeNode& node : root.children) {
+        if (!IsDeclaration(node)) continue;
+
+        const SyntaxTreeNode& symNode = node.child(0);
+        SymbolInfo& info = symInfo[symNode.data<LabelRefNode>()];
+
+        if (node.data<DirectiveNode>() == Directive::EXTERNAL) {
+            if (info.isDefined) {
+                Log::error(symNode, Log::Code::Symbol) << "External symbol is also defined in this file.\n";
+                status = false;
+            }
+            info.isExternal = true;
+        } else {
+            if (!info.isDefined) {
+                Log::error(symNode, Log::Code::Symbol) << "Exported symbol is not defined in this file.\n";
+                status = false;
+            }
+            info.isExported = true;
+        }
+    }
+    for (const SyntaxTreeNode& node : root.children) {
+        const SyntaxTreeNode* refNode = IsDeclaration(node) ? nullptr : FindLabelRef(node);
+
+        if (refNode == nullptr) continue;
+
+        const SymbolInfo& info = symInfo[refNode->data<LabelRefNode>()];
+
+        if (!info.isDefined && !info.isExternal) {
+            Log::error(*refNode, Log::Code::Symbol) << "Reference to undefined symbol.\n";
+            status = false;
+        }
+    }
+    return status;
+}
+
+static bool AssignAddresses(const SyntaxTreeNode& root, std::vector<SymbolInfo>& symInfo,
+                            SymbolTable& symTable)
+{
+    bool status = true;
+    ProgramCounter progCounter;
+    std::vector<const SyntaxTreeNode*> pendingLabels;
+    size_t numSections = 0;
+    LC3::Word sectionOrigin;
+
+    for (const SyntaxTreeNode& node : root.children) {
+        if (node.type == NodeType::LabelDefn) {
+            pendingLabels.push_back(&node);
+
+            continue;
+        }
+        // Declarations take up no memory, and may come before .ORIG.
+        if (node.type != NodeType::Instruction && node.type != NodeType::Directive) continue;
+        if (IsDeclaration(node)) continue;
+
+        progCounter.update(node);
+
+        if (node.type == NodeType::Directive) {
+            Directive dirType = node.data<DirectiveNode>();
+
+            if (dirType == Directive::ORIG) {
+                ++numSections;
+                sectionOrigin = progCounter.address();
+            } else if (dirType == Directive::END && !pendingLabels.empty()) {
+                Log::error(node, Log::Code::Section) << "Label to unaddressed memory.\n";
+                status = false;
+
+                pendingLabels.clear();
+            }
+        }
+        for (const SyntaxTreeNode* labelNode : pendingLabels) {
+            SymbolId symbolId = labelNode->data<LabelDefnNode>();
+
+            symTable.add(symbolId, progCounter.address());
+            symInfo[symbolId].section = numSections - 1;
+            symInfo[symbolId].offset = progCounter.address().value() - sectionOrigin.value();
+        }
+        pendingLabels.clear();
+    }
+    for (const SyntaxTreeNode* labelNode : pendingLabels) {
+        Log::error(*labelNode, Log::Code::Section) << "Label to unaddressed memory.\n";
+        status = false;
+    }
+    return status;
+}
+
+static uint32_t GetObjectSymbol(SymbolId symbolId, const SymbolTable& symTable,
+                                std::vector<SymbolInfo>& symInfo, ObjectFile& object)
+{
+    SymbolInfo& info = symInfo[symbolId];
+
+    if (!info.objectIndex) {
+        StringView name = symTable.name(symbolId);
+        ObjectFile::Symbol symbol;
+
+        symbol.name.assign(name.data(), name.size());
+
+        if (info.isExternal) {
+            symbol.binding = Binding::Imported;
+        } else {
+            symbol.binding = info.isExported ? Binding::Exported : Binding::Local;
+            symbol.section = static_cast<uint32_t>(info.section);
+            symbol.offset = info.offset;
+        }
+        info.objectIndex = static_cast<uint32_t>(object.symbols.size());
+        object.symbols.push_back(std::move(symbol));
+    }
+    return *info.objectIndex;
+}
+
+bool ObjectAssembler::assemble(SyntaxTreeNode& root, const SymbolInterner& symbols,
+                               ObjectFile& object)
+{
+    assert(root.type == NodeType::Root);
+
+    if (!TreeAnalyzer::analyze(root, true)) {
+        return false;
+    }
+    std::vector<SymbolInfo> symInfo(symbols.size());
+    SymbolTable symTable{ symbols };
+
+    if (!CollectSymbols(root, symInfo) || !AssignAddresses(root, symInfo, symTable)) {
+        return false;
+    }
+    ProgramCounter progCounter;
+    bool encodeStatus = true;
+
+    object = ObjectFile{};
+
+    for (const SyntaxTreeNode& node : root.children) {
+        progCounter.update(node);
+
+        if (node.type == NodeType::Directive && node.data<DirectiveNode>() == Directive::ORIG) {
+            object.sections.push_back({ progCounter.address(), {}, {} });
+
+            continue;
+        }
+        size_t stmtSize = Encoder::statementSize(node);
+
+        if (stmtSize == 0) continue;
+
+        ObjectFile::Section& section = object.sections.back();
+        const SyntaxTreeNode* refNode = FindLabelRef(node);
+        RelocationType fieldType = GetFieldType(node);
+
+        std::optional<SymbolId> relocSym;
+        std::optional<LC3::Word> symAddr;
+
+        if (refNode != nullptr) {
+            SymbolId symbolId = refNode->data<LabelRefNode>();
+            const SymbolInfo& info = symInfo[symbolId];
+
+            // The linker may move the sections of a module apart, so only
+            // PC-relative references within a section stay as they are.
+            bool inSection = !info.isExternal && info.section + 1 == object.sections.size();
+
+            if (info.isExternal || (IsPcRelative(fieldType) && !inSection)) {
+                // Stand in an address that encodes as a zero field, which
+                // the linker then fills in.
+                LC3::Word placeholder = IsPcRelative(fieldType) ? progCounter.nextAddress() : 0;
+
+                symAddr = symTable.get(symbolId);
+                symTable.add(symbolId, placeholder);
+                relocSym = symbolId;
+            } else if (!IsPcRelative(fieldType)) {
+                relocSym = symbolId;
+            }
+        }
+        size_t wordOffset = section.words.size();
+
+        if (!Encoder::encodeStatement(node, symTable, progCounter, section.words, wordOffset)) {
+            encodeStatus = false;
+            section.words.resize(wordOffset + stmtSize);
+        }
+        if (!relocSym) continue;
+
+        if (symAddr) {
+            symTable.add(*relocSym, *symAddr);
+        }
+
+        uint32_t symIndex = GetObjectSymbol(*relocSym, symTable, symInfo, object);
+
+        // Every word of a .BLKW holds the label's address.
+        for (size_t i = 0; i < stmtSize; ++i) {
+            section.relocations.push_back({
+                static_cast<uint32_t>(wordOffset + i), fieldType, symIndex
+            });
+        }
+    }
+    for (SymbolId symbolId = 0; symbolId < symInfo.size(); ++symbolId) {
+        if (symInfo[symbolId].isExported) {
+            GetObjectSymbol(symbolId, symTable, symInfo, object);
+        }
+    }
+    return encodeStatus;
+}
+
+} // namespace LC3::Language
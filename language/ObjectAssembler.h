@@ -0,0 +1,23 @@
+#pragma once
+
+#include <ObjectFile.h>
+#include "SymbolInterner.h"
+#include "SyntaxTreeNode.h"
+
+namespace LC3::Language {
+
+// Assembles a program into a relocatable object instead of an image.
+//
+// Labels named by .EXTERNAL are imported from other modules and those named
+// by .GLOBAL are exported to them. Fields that refer to an imported symbol,
+// or hold a PC-relative offset to another section, are left zero, and
+// fields that hold a label's absolute address are encoded as if the section
+// stayed at its .ORIG address. All of them are recorded as relocations for
+// the linker to fill in.
+class ObjectAssembler {
+public:
+    static bool assemble(SyntaxTreeNode& root, const SymbolInterner& symbols,
+                         ObjectFile& object);
+};
+
+} // namespace LC3::Language
@@ -0,0 +1,403 @@
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <lc3/Word.h>
+#include "keywords/Directives.h"
+#include "keywords/InstructionForms.h"
+#include "TreeNodes.h"
+#include "ProgramCounter.h"
+#include "Optimizer.h"
+
+namespace LC3::Language {
+
+using Keywords::Directive;
+using Keywords::Instruction;
+using Keywords::InstructionForm;
+using Keywords::InstructionForms;
+using Keywords::OperandKind;
+
+namespace {
+
+struct Statement {
+    SyntaxTreeNode* node = nullptr;
+    LC3::WordValue address = 0;
+
+    // Whether a label leads here, and whether one of them is used as data,
+    // which pins the statement in place.
+    bool labeled = false;
+    bool pinned = false;
+
+    bool dropped = false;
+};
+
+constexpr size_t NoStatement = static_cast<size_t>(-1);
+
+// Branches are only followed this many hops, which also ends loops.
+constexpr size_t MaxBranchHops = 8;
+
+} // namespace
+
+static bool IsInstruction(const Statement& stmt, Instruction instr) {
+    return stmt.node->type == NodeType::Instruction &&
+           stmt.node->data<InstructionNode>().type == instr;
+}
+
+static const InstructionForm* GetForm(const SyntaxTreeNode& node) {
+    if (node.type != NodeType::Instruction) {
+        return nullptr;
+    }
+    const auto& instrData = node.data<InstructionNode>();
+
+    return InstructionForms::find(instrData.type, instrData.format);
+}
+
+static LC3::WordValue GetRegister(const SyntaxTreeNode& node, size_t index) {
+    return node.child(index).data<RegisterNode>().value();
+}
+
+static const BRFlagsData& GetBranchFlags(const Statement& stmt) {
+    return stmt.node->child(0).data<BRFlagsNode>();
+}
+
+// Whether a branch with flags first is taken whenever one with flags second
+// is.
+static bool Covers(const BRFlagsData& first, const BRFlagsData& second) {
+    return (first.n || !second.n) && (first.z || !second.z) && (first.p || !second.p);
+}
+
+static bool IsUnconditional(const Statement& stmt) {
+    if (IsInstruction(stmt, Instruction::BR)) {
+        const BRFlagsData& flags = GetBranchFlags(stmt);
+
+        return flags.n && flags.z && flags.p;
+    }
+    return IsInstruction(stmt, Instruction::JMP) || IsInstruction(stmt, Instruction::RET);
+}
+
+// Whether an instruction is ADD or AND with an immediate of zero.
+static bool HasZeroImmediate(const Statement& stmt, Instruction instr) {
+    return IsInstruction(stmt, instr) &&
+           stmt.node->data<InstructionNode>().format == NodeFormat::RegRegNum &&
+           stmt.node->child(2).data<NumberNode>().value() == 0;
+}
+
+static bool SetsConditionCodes(const Statement& stmt) {
+    if (stmt.node->type != NodeType::Instruction) {
+        return false;
+    }
+    switch (stmt.node->data<InstructionNode>().type) {
+        case Instruction::ADD:
+        case Instruction::AND:
+        case Instruction::NOT:
+        case Instruction::LD:
+        case Instruction::LDI:
+        case Instruction::LDR:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+// Whether an instruction sets the condition codes and a new value for reg
+// that does not depend on the old one.
+static bool Overwrites(const Statement& stmt, LC3::WordValue reg) {
+    if (!SetsConditionCodes(stmt) || GetRegister(*stmt.node, 0) != reg) {
+        return false;
+    }
+    const SyntaxTreeNode& node = *stmt.node;
+
+    for (size_t i = 1; i < node.children.size(); ++i) {
+        if (node.child(i).type == NodeType::Register && GetRegister(node, i) == reg) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::optional<LC3::WordValue> GetBranchTarget(const Statement& stmt,
+                                                     const SymbolTable& symTable)
+{
+    if (!IsInstruction(stmt, Instruction::BR) ||
+        stmt.node->child(1).type != NodeType::LabelRef)
+    {
+        return std::nullopt;
+    }
+    auto addr = symTable.get(stmt.node->child(1).data<LabelRefNode>());
+
+    assert(addr.has_value());
+
+    return addr->value();
+}
+
+static bool FitsBranchOffset(LC3::WordValue from, LC3::WordValue to) {
+    int32_t offset = static_cast<int32_t>(to) - (static_cast<int32_t>(from) + 1);
+
+    return offset >= -256 && offset <= 255;
+}
+
+// Points a branch that lands on another branch taken under the same
+// conditions at that branch's target instead, as long as both stay in the
+// same section. Dropping statements only brings the two closer together.
+static bool ThreadBranches(std::vector<Statement>& stmts, const std::vector<size_t>& sections,
+                           const std::vector<size_t>& stmtAtSymbol, const SymbolTable& symTable)
+{
+    bool changed = false;
+
+    for (size_t i = 0; i < stmts.size(); ++i) {
+        if (!GetBranchTarget(stmts[i], symTable)) continue;
+
+        SyntaxTreeNode& targetRef = stmts[i].node->child(1);
+        const BRFlagsData& flags = GetBranchFlags(stmts[i]);
+        SymbolId symbolId = targetRef.data<LabelRefNode>();
+
+        for (size_t hop = 0; hop < MaxBranchHops; ++hop) {
+            size_t target = stmtAtSymbol[symbolId];
+
+            if (target == NoStatement || target == i || !GetBranchTarget(stmts[target], symTable) ||
+                !Covers(GetBranchFlags(stmts[target]), flags))
+            {
+                break;
+            }
+            SymbolId nextId = stmts[target].node->child(1).data<LabelRefNode>();
+            size_t next = stmtAtSymbol[nextId];
+
+            if (nextId == symbolId || next == NoStatement || sections[next] != sections[i] ||
+                !FitsBranchOffset(stmts[i].address, symTable.get(nextId)->value()))
+            {
+                break;
+            }
+            symbolId = nextId;
+        }
+        if (symbolId != targetRef.data<LabelRefNode>()) {
+            targetRef.data<LabelRefNode>() = symbolId;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+static size_t NextLive(const std::vector<Statement>& stmts, size_t index) {
+    for (++index; index < stmts.size(); ++index) {
+        if (!stmts[index].dropped) return index;
+    }
+    return NoStatement;
+}
+
+static bool DropStatements(std::vector<Statement>& stmts, const std::vector<size_t>& stmtAtSymbol) {
+    bool changed = false;
+
+    auto drop = [&changed](Statement& stmt) {
+        if (!stmt.pinned && !stmt.dropped) {
+            stmt.dropped = true;
+            changed = true;
+        }
+    };
+
+    // Branches that never branch. A labeled one is kept, in case it is the
+    // last statement of its section.
+    for (Statement& stmt : stmts) {
+        if (IsInstruction(stmt, Instruction::BR) && !stmt.labeled) {
+            const BRFlagsData& flags = GetBranchFlags(stmt);
+
+            if (!flags.n && !flags.z && !flags.p) drop(stmt);
+        }
+    }
+    // Code that control never falls into and no label leads to.
+    for (size_t i = 0; i < stmts.size(); ++i) {
+        if (stmts[i].dropped || !IsUnconditional(stmts[i])) continue;
+
+        size_t j = i + 1;
+
+        for (; j < stmts.size(); ++j) {
+            if (stmts[j].labeled || stmts[j].node->type != NodeType::Instruction) break;
+
+            drop(stmts[j]);
+        }
+        i = j - 1;
+    }
+    // Instructions whose only effects the next one overwrites, and tests
+    // of a register the previous one already set the condition codes from.
+    size_t prev = NoStatement;
+
+    for (size_t i = 0; i < stmts.size(); ++i) {
+        if (stmts[i].dropped) continue;
+
+        size_t next = NextLive(stmts, i);
+
+        if (next == NoStatement) break;
+
+        const Statement& stmt = stmts[i];
+        const Statement& nextStmt = stmts[next];
+
+        if (HasZeroImmediate(stmt, Instruction::AND) &&
+            Overwrites(nextStmt, GetRegister(*stmt.node, 0)))
+        {
+            drop(stmts[i]);
+        } else if (HasZeroImmediate(stmt, Instruction::ADD) &&
+                   GetRegister(*stmt.node, 0) == GetRegister(*stmt.node, 1))
+        {
+            LC3::WordValue reg = GetRegister(*stmt.node, 0);
+            bool alreadySet = prev != NoStatement && !stmt.labeled &&
+                              SetsConditionCodes(stmts[prev]) &&
+                              GetRegister(*stmts[prev].node, 0) == reg;
+
+            if (SetsConditionCodes(nextStmt) || alreadySet) {
+                drop(stmts[i]);
+            }
+        }
+        if (!stmts[i].dropped) {
+            prev = i;
+        }
+    }
+    // Branches to whatever comes next anyway, from the last one back, so
+    // that a run of them all goes.
+    for (size_t i = stmts.size(); i-- > 0;) {
+        if (stmts[i].dropped || !IsInstruction(stmts[i], Instruction::BR) ||
+            stmts[i].node->child(1).type != NodeType::LabelRef)
+        {
+            continue;
+        }
+        // The label moves on to the next statement if its own was dropped.
+        size_t target = stmtAtSymbol[stmts[i].node->child(1).data<LabelRefNode>()];
+        size_t next = NextLive(stmts, i);
+
+        if (target != NoStatement && target > i && next != NoStatement &&
+            NextLive(stmts, target - 1) == next)
+        {
+            drop(stmts[i]);
+        }
+    }
+    return changed;
+}
+
+// The value that a .FILL or .BLKW stores, if it is a number.
+static const SyntaxTreeNode* GetStoredNumber(const Statement& stmt) {
+    if (stmt.node->type != NodeType::Directive) {
+        return nullptr;
+    }
+    const auto& children = stmt.node->children;
+    Directive dirType = stmt.node->data<DirectiveNode>();
+    size_t index = (dirType == Directive::FILL) ? 0 : 1;
+
+    if ((dirType != Directive::FILL && dirType != Directive::BLKW) || index >= children.size() ||
+        children[index].type != NodeType::Number)
+    {
+        return nullptr;
+    }
+    return &children[index];
+}
+
+// Whether an address lies in one of the [start, end) ranges.
+static bool InSection(const std::vector<std::pair<uint32_t, uint32_t>>& ranges,
+                      LC3::WordValue address)
+{
+    for (const auto& range : ranges) {
+        if (address >= range.first && address < range.second) return true;
+    }
+    return false;
+}
+
+bool Optimizer::optimize(SyntaxTreeNode& root, const SymbolTable& symTable) {
+    assert(root.type == NodeType::Root);
+
+    std::vector<Statement> stmts;
+    std::vector<size_t> sections;
+    std::vector<size_t> stmtAtSymbol(symTable.size(), NoStatement);
+    std::vector<SymbolId> pendingSyms;
+    std::vector<std::pair<uint32_t, uint32_t>> sectionRanges;
+    ProgramCounter progCounter;
+    size_t section = 0;
+
+    for (SyntaxTreeNode& node : root.children) {
+        if (node.type == NodeType::LabelDefn) {
+            pendingSyms.push_back(node.data<LabelDefnNode>());
+
+            continue;
+        }
+        if (node.type != NodeType::Instruction && node.type != NodeType::Directive) continue;
+
+        progCounter.update(node);
+
+        uint32_t address = progCounter.address().value();
+
+        if (node.type == NodeType::Directive && node.data<DirectiveNode>() == Directive::ORIG) {
+            ++section;
+            sectionRanges.emplace_back(address, address);
+        } else if (!sectionRanges.empty()) {
+            LC3::WordValue size = progCounter.nextAddress().value() - address;
+
+            sectionRanges.back().second = address + size;
+        }
+        for (SymbolId symbolId : pendingSyms) {
+            stmtAtSymbol[symbolId] = stmts.size();
+        }
+        stmts.push_back({ &node, progCounter.address().value(), !pendingSyms.empty() });
+        sections.push_back(section);
+        pendingSyms.clear();
+    }
+    // Labels used other than as the target of a branch or call pin their
+    // statements, literals among them. Numeric addresses rule out dropping
+    // anything: PC offsets, and data that points into a section, such as a
+    // table of trap or interrupt vectors.
+    bool mayDrop = true;
+
+    for (const Statement& stmt : stmts) {
+        const InstructionForm* form = GetForm(*stmt.node);
+        const auto& children = stmt.node->children;
+
+        if (const SyntaxTreeNode* stored = GetStoredNumber(stmt)) {
+            if (InSection(sectionRanges, stored->data<NumberNode>().value())) {
+                mayDrop = false;
+            }
+        }
+        for (size_t i = 0; i < children.size(); ++i) {
+            bool isPcOffset = form != nullptr && i < form->operands.size() &&
+                              form->operands[i].kind == OperandKind::PcOffset;
+            bool isLiteral = children[i].type == NodeType::Literal;
+            const SyntaxTreeNode& operand = isLiteral ? children[i].child(0) : children[i];
+
+            if (operand.type == NodeType::Number &&
+                (isLiteral ? InSection(sectionRanges, operand.data<NumberNode>().value()) :
+                             isPcOffset))
+            {
+                mayDrop = false;
+            }
+            if (operand.type != NodeType::LabelRef) continue;
+
+            bool isControl = !isLiteral && isPcOffset && (form->instr == Instruction::BR ||
+                                                          form->instr == Instruction::JSR);
+            size_t target = stmtAtSymbol[operand.data<LabelRefNode>()];
+
+            if (!isControl && target != NoStatement) {
+                stmts[target].pinned = true;
+            }
+        }
+    }
+    bool changed = ThreadBranches(stmts, sections, stmtAtSymbol, symTable);
+
+    if (!mayDrop || !DropStatements(stmts, stmtAtSymbol)) {
+        return changed;
+    }
+    std::vector<SyntaxTreeNode> children;
+    children.reserve(root.children.size());
+
+    auto stmt = stmts.begin();
+
+    for (SyntaxTreeNode& node : root.children) {
+        if (stmt != stmts.end() && stmt->node == &node) {
+            bool dropped = stmt->dropped;
+            ++stmt;
+
+            if (dropped) continue;
+        }
+        children.push_back(std::move(node));
+    }
+    root.children = std::move(children);
+
+    return true;
+}
+
+} // namespace LC3::Language
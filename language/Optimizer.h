@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SymbolTable.h"
+#include "SyntaxTreeNode.h"
+
+namespace LC3::Language {
+
+// Rewrites an analyzed program into one that runs in fewer instructions,
+// with peephole rules aimed at the code a simple compiler emits:
+//
+// - A branch to an unconditional branch, or to one taken under every
+//   condition the first was, goes straight to the final target.
+// - Instructions after a BRnzp, JMP or RET that no label leads to are
+//   dropped, as are branches to the next instruction and branches with no
+//   flags, which never branch.
+// - AND Rd, Rs, #0 is dropped when the next instruction overwrites Rd and
+//   the condition codes without reading Rd.
+// - ADD Rx, Rx, #0 is dropped when the next instruction sets the condition
+//   codes anyway, or when the one before it set them from Rx already.
+//
+// Dropping a statement moves the ones after it in its section down, along
+// with their labels, so the symbol table has to be made again afterwards.
+// Statements under a label that is used as data or as a literal are never
+// dropped, and nothing is dropped from a program that gives an instruction
+// a numeric address or stores a number that points into a section, since it
+// might point past a dropped statement.
+class Optimizer {
+public:
+    // Returns whether anything changed. symTable must have been made from
+    // root as it is.
+    static bool optimize(SyntaxTreeNode& root, const SymbolTable& symTable);
+};
+
+} // namespace LC3::Language
@@ -1,21 +1,242 @@
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
 #include <utility>
+#include <vector>
+#include <Log.h>
 #include <util/ParseState.h>
+#include <util/ThreadPool.h>
+#include "keywords/Directives.h"
 #include "ParserContext.h"
+#include "SourceFile.h"
+#include "IncludeCache.h"
+#include "TreeNodes.h"
 #include "Grammar.h"
 #include "Parser.h"
 
 namespace LC3::Language {
 
+using Keywords::Directive;
 using Util::ParseState;
 
-std::optional<SyntaxTreeNode> Parser::parse(StringView src) {
-    ParserContext context{ src };
+namespace {
+
+struct Chunk {
+    StringView src;
+    uint32_t baseOffset = 0;
+
+    std::optional<SyntaxTreeNode> tree;
+    SymbolInterner symbols;
+
+    Log::Context log;
+
+    // Set when the chunk's last token is the linebreak that closes it. If
+    // it is not, the split fell inside a token (a string spanning lines)
+    // and the next chunk was lexed from the wrong state.
+    bool endsCleanly = false;
+};
+
+} // namespace
+
+static void ParseChunk(Chunk& chunk, const SourceFile* srcFile) {
+    std::optional<SourceFile::Scope> srcScope;
+
+    if (srcFile != nullptr) {
+        srcScope.emplace(*srcFile);
+    }
+    Log::Scope logScope{ chunk.log };
+
+    ParserContext context{ chunk.src, chunk.symbols, chunk.baseOffset };
     ParseState status = Grammar::Document::parse(context);
 
-    if (status != ParseState::Success) {
+    const TokenBuffer& tokens = context.tokens;
+    const Token& lastToken = tokens[tokens.size() - 2];
+    uint32_t chunkEnd = chunk.baseOffset + static_cast<uint32_t>(chunk.src.size());
+
+    chunk.endsCleanly = tokens.size() >= 2 &&
+                        lastToken.type == TokenType::Linebreak &&
+                        lastToken.location.offset + 1 == chunkEnd;
+
+    if (status == ParseState::Success) {
+        chunk.tree.emplace(std::move(context.tree.treeTop()));
+    }
+}
+
+// Splits src after a newline roughly every src.size() / numChunks bytes.
+static std::vector<std::unique_ptr<Chunk>> SplitChunks(StringView src, size_t numChunks) {
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    size_t targetSize = src.size() / numChunks;
+    size_t chunkStart = 0;
+
+    while (chunkStart < src.size()) {
+        size_t chunkEnd = src.size();
+
+        if (chunks.size() + 1 < numChunks && chunkStart + targetSize < src.size()) {
+            const char* searchStart = src.data() + chunkStart + targetSize;
+            size_t searchLen = src.size() - (chunkStart + targetSize);
+            auto newline = static_cast<const char*>(std::memchr(searchStart, '\n', searchLen));
+
+            if (newline != nullptr) {
+                chunkEnd = static_cast<size_t>(newline - src.data()) + 1;
+            }
+        }
+        auto chunk = std::make_unique<Chunk>();
+        chunk->src = src.subString(chunkStart, chunkEnd - chunkStart);
+        chunk->baseOffset = static_cast<uint32_t>(chunkStart);
+
+        chunks.push_back(std::move(chunk));
+        chunkStart = chunkEnd;
+    }
+    return chunks;
+}
+
+static void RemapSymbols(SyntaxTreeNode& tree, const std::vector<SymbolId>& idMap) {
+    tree.walk([&idMap](SyntaxTreeNode& node) {
+        if (node.type == NodeType::LabelDefn) {
+            auto& symbolId = node.data<LabelDefnNode>();
+            symbolId = idMap[symbolId];
+        } else if (node.type == NodeType::LabelRef) {
+            auto& symbolId = node.data<LabelRefNode>();
+            symbolId = idMap[symbolId];
+        }
+    });
+}
+
+// Only a directive that names its file with a single string is expanded.
+// Any other form is left for TreeAnalyzer to report.
+static bool IsInclude(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Directive &&
+           node.data<DirectiveNode>() == Directive::INCLUDE &&
+           node.children.size() == 1 &&
+           node.child(0).type == NodeType::String;
+}
+
+static bool ExpandIncludes(SyntaxTreeNode& root, SymbolInterner& symbols,
+                           const std::string& directory, size_t depth)
+{
+    if (std::none_of(root.children.begin(), root.children.end(), IsInclude)) {
+        return true;
+    }
+    std::vector<SyntaxTreeNode> children;
+    children.reserve(root.children.size());
+
+    for (SyntaxTreeNode& node : root.children) {
+        if (!IsInclude(node)) {
+            children.push_back(std::move(node));
+
+            continue;
+        }
+        const std::string& path = *node.child(0).data<StringNode>();
+
+        if (depth == Parser::MaxIncludeDepth) {
+            Log::error(node, Log::Code::IO) << "Includes are nested too deeply. "
+                                            << "Does a file end up including itself?\n";
+            return false;
+        }
+        auto file = IncludeCache::load(path, directory);
+
+        if (!file) {
+            Log::error(node, Log::Code::IO) << "Unable to read included file " << path << ".\n";
+
+            return false;
+        }
+        // The program's statements point into the file from here on.
+        if (const SourceFile* srcFile = SourceFile::active()) {
+            srcFile->addInclude(file->path, file);
+        }
+        // Parsed anew for every program, since labels are interned into its
+        // own symbols.
+        ParserContext context{ TokenBuffer{ std::vector<Token>(file->tokens) }, symbols };
+
+        if (Grammar::Document::parse(context) != ParseState::Success) {
+            return false;
+        }
+        SyntaxTreeNode& included = context.tree.treeTop();
+
+        if (!ExpandIncludes(included, symbols, directory, depth + 1)) {
+            return false;
+        }
+        children.insert(children.end(),
+                        std::make_move_iterator(included.children.begin()),
+                        std::make_move_iterator(included.children.end()));
+    }
+    root.children = std::move(children);
+
+    return true;
+}
+
+bool Parser::expandIncludes(SyntaxTreeNode& root, SymbolInterner& symbols) {
+    const SourceFile* srcFile = SourceFile::active();
+
+    return ExpandIncludes(root, symbols, srcFile != nullptr ? srcFile->directory() : "", 0);
+}
+
+std::optional<SyntaxTreeNode> Parser::parseSlice(StringView slice, uint32_t baseOffset,
+                                                 SymbolInterner& symbols)
+{
+    ParserContext context{ slice, symbols, baseOffset };
+    ParseState status = Grammar::Document::parse(context);
+
+    if (status != ParseState::Success || !expandIncludes(context.tree.treeTop(), symbols)) {
         return {};
     }
     return { std::move(context.tree.treeTop()) };
 }
 
+std::optional<SyntaxTreeNode> Parser::parse(StringView src, SymbolInterner& symbols,
+                                            size_t maxThreads) {
+    size_t numChunks = std::min(maxThreads, src.size() / MinChunkSize);
+
+    if (numChunks < 2) {
+        return parseSlice(src, 0, symbols);
+    }
+    auto chunks = SplitChunks(src, numChunks);
+    {
+        const SourceFile* srcFile = SourceFile::active();
+        Util::ThreadPool pool{ chunks.size() };
+
+        for (auto& chunk : chunks) {
+            pool.submit([&chunk, srcFile]() { ParseChunk(*chunk, srcFile); });
+        }
+    }
+    for (size_t i = 0; i + 1 < chunks.size(); ++i) {
+        if (!chunks[i]->endsCleanly) {
+            return parseSlice(src, 0, symbols);
+        }
+    }
+    // Parsing stops at the first error, so only the diagnostics up to and
+    // including the first failed chunk would have been reported.
+    SyntaxTreeNode root{ NodeType::Root };
+
+    for (auto& chunk : chunks) {
+        Log::merge(chunk->log);
+
+        if (!chunk->tree) {
+            return {};
+        }
+        // Interning each chunk's names in its own order reproduces the
+        // order of first appearance across the whole source.
+        std::vector<SymbolId> idMap;
+        idMap.reserve(chunk->symbols.size());
+
+        for (SymbolId localId = 0; localId < chunk->symbols.size(); ++localId) {
+            idMap.push_back(symbols.intern(chunk->symbols.name(localId)));
+        }
+        RemapSymbols(*chunk->tree, idMap);
+
+        auto& chunkStmts = chunk->tree->children;
+
+        root.children.insert(root.children.end(),
+                             std::make_move_iterator(chunkStmts.begin()),
+                             std::make_move_iterator(chunkStmts.end()));
+    }
+    if (!expandIncludes(root, symbols)) {
+        return {};
+    }
+    return { std::move(root) };
+}
+
 } // namespace LC3::Language
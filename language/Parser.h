@@ -1,7 +1,10 @@
 #include <optional>
+#include <cstddef>
+#include <cstdint>
 #include "SyntaxTreeNode.h"
 #include "Token.h"
 #include "ParserContext.h"
+#include "SymbolInterner.h"
 
 #pragma once
 
@@ -11,7 +14,32 @@ using Util::StringView;
 
 class Parser {
 public:
-    static std::optional<SyntaxTreeNode> parse(StringView src);
+    // Sources smaller than this are never split across threads.
+    static constexpr size_t MinChunkSize = 1 << 20;
+
+    // Files may include files that include others up to this deep, which
+    // also stops a file that ends up including itself.
+    static constexpr size_t MaxIncludeDepth = 64;
+
+    // Label names met while parsing are interned into symbols.
+    //
+    // Large sources are split at line boundaries into up to maxThreads
+    // chunks that are parsed concurrently and merged in order. The result,
+    // diagnostics included, is the same as parsing in one piece.
+    static std::optional<SyntaxTreeNode> parse(StringView src, SymbolInterner& symbols,
+                                               size_t maxThreads = 1);
+
+    // Parses a run of whole lines cut from a larger source, which starts
+    // baseOffset bytes into it.
+    static std::optional<SyntaxTreeNode> parseSlice(StringView slice, uint32_t baseOffset,
+                                                    SymbolInterner& symbols);
+
+    // Replaces each .INCLUDE directive among the children of root with the
+    // statements of the file it names, which are parsed from tokens kept by
+    // IncludeCache. Relative paths are resolved against the directory of
+    // the active SourceFile, which holds on to the files. Both of the above
+    // do this already.
+    static bool expandIncludes(SyntaxTreeNode& root, SymbolInterner& symbols);
 };
 
 } // namespace LC3::Language
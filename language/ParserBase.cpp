@@ -23,19 +23,19 @@ using Keywords::Directive;
 ParseState ParserBase::DirectiveName::parse(ParserContext& context) {
     assert(context.tree.treeTop() == context.tree.currRoot());
 
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
 
     if (token.type == TokenType::Word) {
         Directive dirType = Directives::get(token.str);
 
         if (dirType != Directive::Invalid) {
-            ++context.tokenizer;
+            ++context.tokens;
             context.tree.descendTree<DirectiveNode>(dirType, token);
 
             return ParseState::Success;
         }
     }
-    Log::error(token) << "Invalid directive name.\n";
+    Log::error(token, Log::Code::Syntax) << "Invalid directive name.\n";
 
     return ParseState::FatalFail;
 }
@@ -59,7 +59,7 @@ static BRFlagsNode MakeBranchFlags(const Token& flagToken) {
         }
     }
     if (!branchFlags.n && !branchFlags.z && !branchFlags.p) {
-        Log::warning(flagToken) << "Branch instruction with no flags is a no-op.\n";
+        Log::warning(flagToken, Log::Code::Syntax) << "Branch instruction with no flags is a no-op.\n";
     }
     return BRFlagsNode(std::move(branchFlags), flagToken);
 }
@@ -67,21 +67,21 @@ static BRFlagsNode MakeBranchFlags(const Token& flagToken) {
 ParseState ParserBase::InstrName::parse(ParserContext& context) {
     assert(context.tree.treeTop() == context.tree.currRoot());
 
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
 
     if (token.type == TokenType::Word) {
         Instruction instrType = Instructions::get(token.str);
 
         if (instrType == Instruction::Invalid) {
             if (context.flags & ErrorMode::Error) {
-                Log::error(token) << "Unknown instruction.\n";
+                Log::error(token, Log::Code::Syntax) << "Unknown instruction.\n";
 
                 return ParseState::FatalFail;
             } else {
                 return ParseState::NonFatalFail;
             }
         }
-        ++context.tokenizer;
+        ++context.tokens;
 
         if (instrType == Instruction::BR) {
             Token flagsToken = token;
@@ -107,25 +107,27 @@ ParseState ParserBase::LabelDefn::parse(ParserContext& context) {
     assert(context.tree.treeTop() == context.tree.currRoot());
 
     SyntaxTreeBuilder::DescentGuard guard{ context.tree };
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
 
     if (token.type != TokenType::Word) {
         return ParseState::NonFatalFail;
     }
-    Token nextToken = context.tokenizer.peek(1);
+    const Token& nextToken = context.tokens.peek(1);
 
     // A strange quirk of LC-3 is that labels can be reserved words,
     // even valid hexadecimal numbers, if they are followed by a colon.
     if (nextToken.type == TokenType::Colon) {
-        context.tokenizer += 2;
-    
-        context.tree.descendTree(NodeType::LabelDefn, token);
+        context.tokens += 2;
+
+        SymbolId symbolId = context.symbols.intern(token.str);
+        context.tree.descendTree<LabelDefnNode>(symbolId, token);
 
         return ParseState::Success;
     } else if (!Instructions::has(token.str) && !Directives::has(token.str)) {
-        ++context.tokenizer;
+        ++context.tokens;
 
-        context.tree.descendTree(NodeType::LabelDefn, token);
+        SymbolId symbolId = context.symbols.intern(token.str);
+        context.tree.descendTree<LabelDefnNode>(symbolId, token);
 
         return ParseState::Success;
     }
@@ -133,28 +135,26 @@ ParseState ParserBase::LabelDefn::parse(ParserContext& context) {
 }
 
 ParseState ParserBase::LabelRef::parse(ParserContext& context) {
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
 
     if (token.type != TokenType::Word) {
         if (context.flags & ErrorMode::Error) {
-            Log::error(token) << "Unexpected " << token.type << " token.\n";
+            Log::error(token, Log::Code::Syntax) << "Unexpected " << token.type << " token.\n";
 
             return ParseState::FatalFail;
         }
         return ParseState::NonFatalFail;
     }
-    ++context.tokenizer;
-
-    SyntaxTreeNode& treeNode = context.tree.descendTree();
+    ++context.tokens;
 
-    treeNode.type = NodeType::LabelRef;
-    treeNode.token = std::move(token);
+    SymbolId symbolId = context.symbols.intern(token.str);
+    context.tree.descendTree<LabelRefNode>(symbolId, token);
 
     return ParseState::Success;
 }
 
 ParseState ParserBase::HexNumber::parse(ParserContext& context) {
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
 
     if (token.type != TokenType::Word) {
         return ParseState::NonFatalFail;
@@ -162,7 +162,7 @@ ParseState ParserBase::HexNumber::parse(ParserContext& context) {
     if (!IsValid(token.str)) {
         return ParseState::NonFatalFail;
     }
-    ++context.tokenizer;
+    ++context.tokens;
 
     // Removes the leading 'x' character, leaving only the hex digits.
     token.str = token.str.subString(1);
@@ -190,16 +190,16 @@ bool ParserBase::HexNumber::IsValid(const StringView& tokenStr) {
 }
 
 ParseState ParserBase::DecNumberDefn::parse(ParserContext& context) {
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
     bool isNegative = false;
 
     if (token.type == TokenType::Minus) {
         isNegative = true;
-        token = *++context.tokenizer;
+        token = *++context.tokens;
     }
     if (token.type != TokenType::Number) {
         if (context.flags & ErrorMode::Error) {
-            Log::error(token) << "Expected number but got " << token.type << ".\n";
+            Log::error(token, Log::Code::Syntax) << "Expected number but got " << token.type << ".\n";
 
             return ParseState::FatalFail;
         } else {
@@ -208,14 +208,14 @@ ParseState ParserBase::DecNumberDefn::parse(ParserContext& context) {
     }
     if (!DecNumberDefn::IsValid(token.str)) {
         if (context.flags & ErrorMode::Error) {
-            Log::error() << "Invalid number format.\n";
+            Log::error(Log::Code::Syntax) << "Invalid number format.\n";
 
             return ParseState::FatalFail;
         } else {
             return ParseState::NonFatalFail;
         }
     }
-    ++context.tokenizer;
+    ++context.tokens;
 
     LC3::Word parsedNum(std::strtoul(token.str.data(), nullptr, 10));
 
@@ -266,12 +266,12 @@ static std::string GetString(const StringView& tokenStr) {
 }
 
 ParseState ParserBase::String::parse(ParserContext& context) {
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
 
     if (token.type != TokenType::String) {
         return ParseState::NonFatalFail;
     }
-    ++context.tokenizer;
+    ++context.tokens;
 
     auto strVal = std::make_shared<std::string>(GetString(token.str));
     context.tree.descendTree<StringNode>(std::move(strVal), token);
@@ -280,7 +280,7 @@ ParseState ParserBase::String::parse(ParserContext& context) {
 }
 
 ParseState ParserBase::Register::parse(ParserContext& context) {
-    Token token = *context.tokenizer;
+    Token token = *context.tokens;
 
     if (token.type != TokenType::Word) {
         return ParseState::NonFatalFail;
@@ -291,7 +291,7 @@ ParseState ParserBase::Register::parse(ParserContext& context) {
     if (token.str.beginsWith("R", CaselessCompare()) &&
         (token.str[1] >= '0' && token.str[1] <= '7'))
     {
-        ++context.tokenizer;
+        ++context.tokens;
 
         LC3::Word regNum(token.str[1] - '0');
         context.tree.descendTree<RegisterNode>(regNum, token);
@@ -301,5 +301,18 @@ ParseState ParserBase::Register::parse(ParserContext& context) {
     return ParseState::NonFatalFail;
 }
 
+ParseState ParserBase::LiteralSign::parse(ParserContext& context) {
+    Token token = *context.tokens;
+
+    if (token.type != TokenType::Equals) {
+        return ParseState::NonFatalFail;
+    }
+    ++context.tokens;
+
+    context.tree.descendTree<LiteralNode>(token);
+
+    return ParseState::Success;
+}
+
 } // namespace LC3::Language
 
@@ -3,7 +3,7 @@
 #include <Log.h>
 #include <util/GenericParser.h>
 #include "Token.h"
-#include "Tokenizer.h"
+#include "TokenBuffer.h"
 #include "ParserContext.h"
 
 namespace LC3::Language {
@@ -35,15 +35,15 @@ public:
     template <TokenType ExpectedType>
     struct Atom : public ParserElement {
         static ParseState parse(ParserContext& context) {
-            Token token = *context.tokenizer;
+            Token token = *context.tokens;
 
             if (token.type == ExpectedType) {
-                ++context.tokenizer;
+                ++context.tokens;
 
                 return ParseState::Success;
             }
             if (context.flags & ErrorMode::Error) {
-                Log::error(token) << "Unexpected " << token.type << " token.\n";
+                Log::error(token, Log::Code::Syntax) << "Unexpected " << token.type << " token.\n";
 
                 return ParseState::FatalFail;
             }
@@ -139,6 +139,12 @@ public:
     struct Register : public ParserElement {
         static ParseState parse(ParserContext& context);
     };
+
+    // The = that starts a literal. The value that follows is parsed as its
+    // child.
+    struct LiteralSign : public ParserElement {
+        static ParseState parse(ParserContext& context);
+    };
 };
 
 } // namespace LC3::Language
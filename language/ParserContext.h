@@ -1,19 +1,28 @@
+#include <cstdint>
+#include <utility>
 #include <util/StringView.h>
-#include "Tokenizer.h"
+#include "TokenBuffer.h"
 #include "SyntaxTree.h"
 #include "ParserFlags.h"
+#include "SymbolInterner.h"
 
 #pragma once
 
 namespace LC3::Language {
 
 struct ParserContext {
-    Tokenizer tokenizer;
+    TokenBuffer tokens;
     ParserFlags flags;
     SyntaxTreeBuilder tree;
+    SymbolInterner& symbols;
 
-    ParserContext(const Util::StringView& src) :
-      tokenizer{ src }
+    ParserContext(const Util::StringView& src, SymbolInterner& symbolNames, uint32_t baseOffset = 0) :
+      tokens{ src, baseOffset },
+      symbols{ symbolNames }
+    {}
+    ParserContext(TokenBuffer&& tokenBuffer, SymbolInterner& symbolNames) :
+      tokens{ std::move(tokenBuffer) },
+      symbols{ symbolNames }
     {}
 };
 
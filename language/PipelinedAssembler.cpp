@@ -0,0 +1,123 @@
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Log.h>
+#include <util/ParseState.h>
+#include <util/SpscQueue.h>
+#include "Tokenizer.h"
+#include "TokenBuffer.h"
+#include "ParserContext.h"
+#include "Grammar.h"
+#include "Parser.h"
+#include "Assembler.h"
+#include "PipelinedAssembler.h"
+
+namespace LC3::Language {
+
+using Util::ParseState;
+using Util::SpscQueue;
+
+using TokenBatch = std::vector<Token>;
+using StatementBatch = std::vector<SyntaxTreeNode>;
+
+static void LexStage(StringView src, SpscQueue<TokenBatch>& tokenQueue) {
+    Tokenizer tokenizer{ src };
+    TokenBatch batch;
+
+    for (; tokenizer; ++tokenizer) {
+        batch.push_back(*tokenizer);
+
+        // Batches hold whole lines, which the grammar parses independently.
+        if (batch.size() >= PipelinedAssembler::TokenBatchSize &&
+            batch.back().type == TokenType::Linebreak)
+        {
+            if (!tokenQueue.push(std::move(batch))) {
+                return;
+            }
+            batch = TokenBatch{};
+        }
+    }
+    batch.push_back(*tokenizer);
+
+    tokenQueue.push(std::move(batch));
+    tokenQueue.close();
+}
+
+// The whole source is parsed even when the Assembler has stopped taking
+// statements, since a syntax error anywhere supersedes every other
+// diagnostic.
+static bool ParseStage(const SourceFile& srcFile, SymbolInterner& symbols,
+                       SpscQueue<TokenBatch>& tokenQueue,
+                       SpscQueue<StatementBatch>& stmtQueue, Log::Context& stageLog)
+{
+    SourceFile::Scope srcScope{ srcFile };
+    Log::Scope logScope{ stageLog };
+
+    TokenBatch tokens;
+    bool parseStatus = true;
+
+    while (tokenQueue.pop(tokens)) {
+        ParserContext context{ TokenBuffer{ std::move(tokens) }, symbols };
+
+        if (Grammar::Document::parse(context) != ParseState::Success ||
+            !Parser::expandIncludes(context.tree.treeTop(), symbols))
+        {
+            parseStatus = false;
+            break;
+        }
+        stmtQueue.push(std::move(context.tree.treeTop().children));
+    }
+    tokenQueue.close();
+    stmtQueue.close();
+
+    return parseStatus;
+}
+
+bool PipelinedAssembler::assemble(const SourceFile& srcFile, SymbolInterner& symbols,
+                                  LC3Writer& writer)
+{
+    SpscQueue<TokenBatch> tokenQueue{ QueueDepth };
+    SpscQueue<StatementBatch> stmtQueue{ QueueDepth };
+
+    // Created before the parser starts interning, since it reads the
+    // number of symbols.
+    Assembler assembler{ symbols };
+
+    Log::Context parseLog;
+    Log::Context assembleLog;
+    bool parseStatus = false;
+
+    std::thread lexThread{ [&]() { LexStage(srcFile.text(), tokenQueue); } };
+    std::thread parseThread{ [&]() {
+        parseStatus = ParseStage(srcFile, symbols, tokenQueue, stmtQueue, parseLog);
+    } };
+    {
+        Log::Scope logScope{ assembleLog };
+        StatementBatch stmts;
+
+        while (stmtQueue.pop(stmts)) {
+            for (SyntaxTreeNode& node : stmts) {
+                if (assembler.terminated()) {
+                    stmtQueue.close();
+                    break;
+                }
+                assembler.add(std::move(node));
+            }
+        }
+    }
+    parseThread.join();
+    lexThread.join();
+
+    // Keep the order of a sequential run: everything the parser reported
+    // comes first, and nothing else is reported if it failed.
+    Log::merge(parseLog);
+
+    if (!parseStatus) {
+        return false;
+    }
+    Log::merge(assembleLog);
+
+    return assembler.finish(writer);
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <LC3Writer.h>
+#include "SourceFile.h"
+#include "SymbolInterner.h"
+
+namespace LC3::Language {
+
+// Assembles a source as three concurrent stages: the lexer, the parser, and
+// the Assembler, which checks, places and encodes each statement. The
+// stages hand batches of whole lines to each other over bounded queues, so
+// the syntax tree never exists all at once. Labels that are referenced
+// before their definition are resolved by the Assembler's fixups at the
+// end. Output and diagnostics are the same as the single-pass assembler's.
+class PipelinedAssembler {
+public:
+    // A token batch is cut at the first linebreak after this many tokens.
+    static constexpr size_t TokenBatchSize = 4096;
+
+    // Number of batches that may wait between two stages.
+    static constexpr size_t QueueDepth = 8;
+
+    static bool assemble(const SourceFile& srcFile, SymbolInterner& symbols,
+                         LC3Writer& writer);
+};
+
+} // namespace LC3::Language
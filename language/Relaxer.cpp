@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <lc3/Word.h>
+#include "keywords/Directives.h"
+#include "keywords/InstructionForms.h"
+#include "TreeNodes.h"
+#include "Relaxer.h"
+
+namespace LC3::Language {
+
+using Keywords::Directive;
+using Keywords::Instruction;
+using Keywords::InstructionForm;
+using Keywords::InstructionForms;
+using Keywords::OperandKind;
+
+namespace {
+
+struct Statement {
+    size_t nodeIndex = 0;
+    LC3::WordValue address = 0;
+    size_t size = 0;
+    bool relaxed = false;
+
+    // Where the statement was before any rewrite, and the first statement of
+    // its section.
+    LC3::WordValue oldAddress = 0;
+    size_t sectionStart = 0;
+};
+
+constexpr size_t NoStatement = static_cast<size_t>(-1);
+
+// The register far jumps and calls go through. Calls overwrite it anyway.
+constexpr LC3::WordValue LinkRegister = 7;
+
+} // namespace
+
+static const InstructionForm* GetForm(const SyntaxTreeNode& node) {
+    if (node.type != NodeType::Instruction) {
+        return nullptr;
+    }
+    const auto& instrData = node.data<InstructionNode>();
+
+    return InstructionForms::find(instrData.type, instrData.format);
+}
+
+// The PC-relative operand, a label or a numeric address, or NoStatement if
+// there is none.
+static size_t GetTargetIndex(const SyntaxTreeNode& node, const InstructionForm& form) {
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        if (form.operands[i].kind == OperandKind::PcOffset &&
+            (node.child(i).type == NodeType::LabelRef || node.child(i).type == NodeType::Number))
+        {
+            return i;
+        }
+    }
+    return NoStatement;
+}
+
+// Number of words an instruction takes once rewritten, or zero if it cannot
+// be.
+static size_t GetRelaxedSize(const SyntaxTreeNode& node) {
+    switch (node.data<InstructionNode>().type) {
+        case Instruction::BR: {
+            const auto& flags = node.child(0).data<BRFlagsNode>();
+
+            return flags.n && flags.z && flags.p ? 3 : 4;
+        }
+        case Instruction::JSR:
+        case Instruction::LDI:
+            return 4;
+        case Instruction::LD:
+        case Instruction::ST:
+        case Instruction::LEA:
+            return 3;
+        default:
+            break;
+    }
+    return 0;
+}
+
+static size_t GetSize(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Instruction ? InstructionNode::size(node) : DirectiveNode::size(node);
+}
+
+static bool IsOrigDirective(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Directive && node.data<DirectiveNode>() == Directive::ORIG;
+}
+
+// Lays out the statements from first on, the same way ProgramCounter does.
+static void AssignAddresses(const SyntaxTreeNode& root, std::vector<Statement>& stmts, size_t first) {
+    LC3::WordValue nextAddr = 0;
+
+    if (first > 0) {
+        nextAddr = static_cast<LC3::WordValue>(stmts[first - 1].address + stmts[first - 1].size);
+    }
+    for (size_t i = first; i < stmts.size(); ++i) {
+        const SyntaxTreeNode& node = root.children[stmts[i].nodeIndex];
+
+        if (IsOrigDirective(node)) {
+            nextAddr = node.child(0).data<NumberNode>().value();
+        }
+        stmts[i].address = nextAddr;
+        nextAddr = static_cast<LC3::WordValue>(nextAddr + stmts[i].size);
+    }
+}
+
+// The statement in the same section as stmts[from] that a numeric address
+// pointed into before anything moved, or NoStatement if it lies outside the
+// section. An address one past the end of the section counts as the last
+// statement's.
+static size_t FindNumericTarget(const std::vector<Statement>& stmts, size_t from,
+                                LC3::WordValue targetAddr)
+{
+    size_t first = stmts[from].sectionStart;
+    size_t last = from + 1;
+
+    while (last < stmts.size() && stmts[last].sectionStart == first) {
+        ++last;
+    }
+    const Statement& lastStmt = stmts[last - 1];
+    auto sectionEnd = static_cast<LC3::WordValue>(lastStmt.oldAddress + lastStmt.size);
+
+    if (targetAddr < stmts[first].oldAddress || targetAddr > sectionEnd) {
+        return NoStatement;
+    }
+    auto stmt = std::upper_bound(stmts.begin() + first, stmts.begin() + last, targetAddr,
+                                 [](LC3::WordValue addr, const Statement& other) {
+                                     return addr < other.oldAddress;
+                                 }) - 1;
+
+    return static_cast<size_t>(stmt - stmts.begin());
+}
+
+// Where a numeric address that pointed into stmts[target] points now.
+static LC3::WordValue MoveAddress(const Statement& target, LC3::WordValue targetAddr) {
+    return static_cast<LC3::WordValue>(targetAddr + target.address - target.oldAddress);
+}
+
+static SyntaxTreeNode MakeInstruction(Instruction instr, NodeFormat format, const Token& token) {
+    return InstructionNode{ InstructionData{ instr, format }, token };
+}
+
+static SyntaxTreeNode MakeRegister(LC3::WordValue reg, const Token& token) {
+    return RegisterNode{ LC3::Word(reg), token };
+}
+
+static SyntaxTreeNode MakeAddress(LC3::WordValue addr, const Token& token) {
+    return NumberNode{ LC3::Word(addr), token };
+}
+
+static SyntaxTreeNode MakeBranch(BRFlagsData flags, LC3::WordValue target, const Token& token) {
+    SyntaxTreeNode branch = MakeInstruction(Instruction::BR, NodeFormat::Branch, token);
+
+    branch.children.push_back(BRFlagsNode{ flags, token });
+    branch.children.push_back(MakeAddress(target, token));
+
+    return branch;
+}
+
+// Adds the sequence that replaces instr at addr to children. Its literal
+// takes over the label or address operand.
+static void EmitRelaxed(SyntaxTreeNode&& instr, LC3::WordValue addr, size_t size,
+                        std::vector<SyntaxTreeNode>& children)
+{
+    const Token& token = instr.token;
+    Instruction instrType = instr.data<InstructionNode>().type;
+    size_t targetIndex = GetTargetIndex(instr, *GetForm(instr));
+
+    auto litAddr = static_cast<LC3::WordValue>(addr + size - 1);
+    auto overAddr = static_cast<LC3::WordValue>(addr + size);
+
+    auto emit = [&children](SyntaxTreeNode&& node) {
+        children.push_back(std::move(node));
+    };
+    auto emitRegAddr = [&](Instruction type, LC3::WordValue reg) {
+        SyntaxTreeNode node = MakeInstruction(type, NodeFormat::RegAddr, token);
+
+        node.children.push_back(MakeRegister(reg, token));
+        node.children.push_back(MakeAddress(litAddr, token));
+        emit(std::move(node));
+    };
+    auto emitJump = [&](Instruction type) {
+        SyntaxTreeNode node = MakeInstruction(type, NodeFormat::Reg, token);
+
+        node.children.push_back(MakeRegister(LinkRegister, token));
+        emit(std::move(node));
+    };
+    auto emitSkip = [&]() {
+        emit(MakeBranch(BRFlagsData{ true, true, true }, overAddr, token));
+    };
+
+    switch (instrType) {
+        case Instruction::BR: {
+            const auto& flags = instr.child(0).data<BRFlagsNode>();
+
+            if (size == 4) {
+                emit(MakeBranch(BRFlagsData{ !flags.n, !flags.z, !flags.p }, overAddr, token));
+            }
+            emitRegAddr(Instruction::LD, LinkRegister);
+            emitJump(Instruction::JMP);
+            break;
+        }
+        case Instruction::JSR:
+            emitRegAddr(Instruction::LD, LinkRegister);
+            emitJump(Instruction::JSRR);
+            emitSkip();
+            break;
+        case Instruction::LDI: {
+            LC3::WordValue reg = instr.child(0).data<RegisterNode>().value();
+            SyntaxTreeNode load = MakeInstruction(Instruction::LDR, NodeFormat::RegRegAddr, token);
+
+            load.children.push_back(MakeRegister(reg, token));
+            load.children.push_back(MakeRegister(reg, token));
+            load.children.push_back(NumberNode{ LC3::Word(0), token });
+
+            emitRegAddr(Instruction::LDI, reg);
+            emit(std::move(load));
+            emitSkip();
+            break;
+        }
+        case Instruction::LD:
+        case Instruction::ST:
+        case Instruction::LEA: {
+            Instruction type = instrType == Instruction::LD ? Instruction::LDI :
+                               instrType == Instruction::ST ? Instruction::STI :
+                               Instruction::LD;
+
+            emitRegAddr(type, instr.child(0).data<RegisterNode>().value());
+            emitSkip();
+            break;
+        }
+        default:
+            assert(false);
+            break;
+    }
+    SyntaxTreeNode literal = DirectiveNode{ Directive::FILL, token };
+
+    literal.children.push_back(std::move(instr.children[targetIndex]));
+    emit(std::move(literal));
+}
+
+bool Relaxer::relax(SyntaxTreeNode& root, const SymbolTable& symTable) {
+    assert(root.type == NodeType::Root);
+
+    std::vector<Statement> stmts;
+    std::vector<size_t> stmtAtSymbol(symTable.size(), NoStatement);
+    std::vector<SymbolId> pendingSyms;
+
+    for (size_t i = 0; i < root.children.size(); ++i) {
+        const SyntaxTreeNode& node = root.children[i];
+
+        if (node.type == NodeType::LabelDefn) {
+            pendingSyms.push_back(node.data<LabelDefnNode>());
+
+            continue;
+        }
+        if (node.type != NodeType::Instruction && node.type != NodeType::Directive) continue;
+
+        for (SymbolId symbolId : pendingSyms) {
+            stmtAtSymbol[symbolId] = stmts.size();
+        }
+        pendingSyms.clear();
+
+        size_t sectionStart = (IsOrigDirective(node) || stmts.empty()) ?
+                                  stmts.size() :
+                                  stmts.back().sectionStart;
+
+        stmts.push_back({ i, 0, GetSize(node), false, 0, sectionStart });
+    }
+    AssignAddresses(root, stmts, 0);
+
+    // Numeric addresses within a section move along with the statement
+    // they point at, as they do for literal pools, which may have been
+    // placed before this runs.
+    std::vector<size_t> numericTargets(stmts.size(), NoStatement);
+
+    for (size_t i = 0; i < stmts.size(); ++i) {
+        stmts[i].oldAddress = stmts[i].address;
+    }
+    for (size_t i = 0; i < stmts.size(); ++i) {
+        const SyntaxTreeNode& node = root.children[stmts[i].nodeIndex];
+        const InstructionForm* form = GetForm(node);
+        size_t targetIndex = form != nullptr ? GetTargetIndex(node, *form) : NoStatement;
+
+        if (targetIndex != NoStatement && node.child(targetIndex).type == NodeType::Number) {
+            LC3::WordValue targetAddr = node.child(targetIndex).data<NumberNode>().value();
+
+            numericTargets[i] = FindNumericTarget(stmts, i, targetAddr);
+        }
+    }
+    bool changed = false;
+
+    while (true) {
+        size_t firstRelaxed = NoStatement;
+
+        for (size_t i = 0; i < stmts.size(); ++i) {
+            const SyntaxTreeNode& node = root.children[stmts[i].nodeIndex];
+            const InstructionForm* form = GetForm(node);
+
+            if (stmts[i].relaxed || form == nullptr) continue;
+
+            size_t targetIndex = GetTargetIndex(node, *form);
+
+            if (targetIndex == NoStatement) continue;
+
+            const SyntaxTreeNode& operand = node.child(targetIndex);
+            bool isNumeric = operand.type == NodeType::Number;
+            size_t target = isNumeric ? numericTargets[i] :
+                                        stmtAtSymbol[operand.data<LabelRefNode>()];
+
+            if (target == NoStatement) continue;
+
+            LC3::WordValue targetAddr = stmts[target].address;
+
+            if (isNumeric) {
+                targetAddr = MoveAddress(stmts[target], operand.data<NumberNode>().value());
+            }
+            int32_t offset = static_cast<int32_t>(targetAddr) -
+                             (static_cast<int32_t>(stmts[i].address) + 1);
+            int32_t reach = int32_t{ 1 } << (form->operands[targetIndex].width - 1);
+            size_t relaxedSize = GetRelaxedSize(node);
+
+            if ((offset < -reach || offset >= reach) && relaxedSize > 0) {
+                stmts[i].relaxed = true;
+                stmts[i].size = relaxedSize;
+                firstRelaxed = std::min(firstRelaxed, i);
+            }
+        }
+        if (firstRelaxed == NoStatement) break;
+
+        AssignAddresses(root, stmts, firstRelaxed);
+        changed = true;
+    }
+    if (!changed) {
+        return false;
+    }
+    for (size_t i = 0; i < stmts.size(); ++i) {
+        if (numericTargets[i] == NoStatement) continue;
+
+        SyntaxTreeNode& node = root.children[stmts[i].nodeIndex];
+        size_t targetIndex = GetTargetIndex(node, *GetForm(node));
+        LC3::Word& targetAddr = node.child(targetIndex).data<NumberNode>();
+
+        targetAddr = LC3::Word(MoveAddress(stmts[numericTargets[i]], targetAddr.value()));
+    }
+    std::vector<SyntaxTreeNode> children;
+    children.reserve(root.children.size() + 3 * stmts.size());
+
+    auto stmt = stmts.begin();
+
+    for (size_t i = 0; i < root.children.size(); ++i) {
+        if (stmt != stmts.end() && stmt->nodeIndex == i) {
+            bool relaxed = stmt->relaxed;
+            LC3::WordValue addr = stmt->address;
+            size_t size = stmt->size;
+            ++stmt;
+
+            if (relaxed) {
+                EmitRelaxed(std::move(root.children[i]), addr, size, children);
+
+                continue;
+            }
+        }
+        children.push_back(std::move(root.children[i]));
+    }
+    root.children = std::move(children);
+
+    return true;
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "SymbolTable.h"
+#include "SyntaxTreeNode.h"
+
+namespace LC3::Language {
+
+// Rewrites instructions whose label is out of reach of their PC-relative
+// offset into longer sequences that reach it through a literal holding the
+// label's address, placed right behind them:
+//
+//   BRx L    ->  BR(not x) over; LD R7, lit; JMP R7; lit .FILL L; over
+//   BRnzp L  ->  LD R7, lit; JMP R7; lit .FILL L
+//   JSR L    ->  LD R7, lit; JSRR R7; BRnzp over; lit .FILL L; over
+//   LD R, L  ->  LDI R, lit; BRnzp over; lit .FILL L; over
+//   ST R, L  ->  STI R, lit; ...
+//   LDI R, L ->  LDI R, lit; LDR R, R, #0; ...
+//   LEA R, L ->  LD R, lit; ...
+//
+// Far branches clobber R7 and the condition codes on the way to their
+// target, so this only runs when asked for. STI has no sequence that leaves
+// every register alone, and is left to fail as before.
+//
+// Each rewrite moves everything after it, which can put other labels out of
+// reach, so the addresses are worked out again from the first rewritten
+// statement until nothing more needs rewriting. The operands the sequences
+// add are the final addresses they refer to, so the symbol table has to be
+// made again afterwards.
+//
+// A numeric address of a PC-relative operand that falls within its own
+// section keeps pointing at the same statement, and is rewritten like a
+// label if that puts it out of reach. This lets relaxing run again after
+// literal pools are placed, whose loads point at their pools by address.
+class Relaxer {
+public:
+    // Returns whether anything changed. symTable must have been made from
+    // root as it is.
+    static bool relax(SyntaxTreeNode& root, const SymbolTable& symTable);
+};
+
+} // namespace LC3::Language
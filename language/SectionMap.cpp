@@ -0,0 +1,74 @@
+#include <cassert>
+#include <iterator>
+#include <Log.h>
+#include "SectionMap.h"
+
+namespace LC3::Language {
+
+std::optional<LC3::Word> SectionMap::add(LC3::Word origin, size_t size) {
+    // An empty section takes up no addresses, so it cannot overlap anything.
+    if (size == 0) {
+        return std::nullopt;
+    }
+    uint32_t first = origin.value();
+    uint32_t last = first + static_cast<uint32_t>(size);
+
+    auto next = m_ranges.lower_bound(first);
+
+    if (next != m_ranges.end() && next->first < last) {
+        return LC3::Word(static_cast<LC3::WordValue>(next->first));
+    }
+    if (next != m_ranges.begin()) {
+        auto prev = std::prev(next);
+
+        if (prev->second > first) {
+            return LC3::Word(static_cast<LC3::WordValue>(prev->first));
+        }
+    }
+    m_ranges.emplace_hint(next, first, last);
+
+    return std::nullopt;
+}
+
+bool SectionMap::add(LC3::Word origin, size_t size, const Token& token) {
+    // Its length has to fit the header word, so a section cannot fill all of
+    // memory.
+    if (size > LC3::Word::maxValue) {
+        Log::error(token, Log::Code::Section) << "Section is longer than xFFFF words.\n";
+
+        return false;
+    }
+    if (origin.value() + size > LC3::Word::maxValue + size_t{ 1 }) {
+        Log::error(token, Log::Code::Section) << "Section runs past xFFFF, the end of memory.\n";
+
+        return false;
+    }
+    if (auto overlapped = add(origin, size)) {
+        Log::error(token, Log::Code::Section) << "Section overlaps the section at " << *overlapped << ".\n";
+
+        return false;
+    }
+    return true;
+}
+
+bool SectionMap::finish(std::vector<LC3::Word>& image, const std::vector<Section>& sections) {
+    SectionMap sectionMap;
+    bool retStatus = true;
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        size_t start = sections[i].imageOffset;
+        size_t end = i + 1 < sections.size() ? sections[i + 1].imageOffset : image.size();
+
+        assert(start + HeaderSize <= end);
+
+        size_t length = end - start - HeaderSize;
+        image[start + 1] = static_cast<LC3::WordValue>(length);
+
+        if (!sectionMap.add(image[start], length, sections[i].token)) {
+            retStatus = false;
+        }
+    }
+    return retStatus;
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+#include <lc3/Word.h>
+#include "Token.h"
+
+namespace LC3::Language {
+
+// The addresses taken up by a program's sections, one for each .ORIG
+// directive, kept as an interval map so that overlapping sections can be
+// found.
+//
+// In an image, every section starts with a header of two words: its origin
+// and its length. The encoder leaves the length zero, since a section's
+// length is only known once everything after its .ORIG is laid out.
+class SectionMap {
+public:
+    static constexpr size_t HeaderSize = 2;
+
+    struct Section {
+        // Where the section's header lies in the image.
+        size_t imageOffset = 0;
+
+        // The .ORIG directive that starts it.
+        Token token;
+    };
+
+    // Adds the addresses [origin, origin + size). If they overlap a section
+    // that was added before, returns the origin of that section instead.
+    std::optional<LC3::Word> add(LC3::Word origin, size_t size);
+
+    // Adds a section's addresses, and reports it at token if it is too long
+    // for its header, runs past the end of memory or overlaps a section that
+    // was added before.
+    bool add(LC3::Word origin, size_t size, const Token& token);
+
+    // Fills in the length of every section of image, and reports the ones
+    // that add() rejects.
+    static bool finish(std::vector<LC3::Word>& image, const std::vector<Section>& sections);
+
+private:
+    // Maps the first address of each section to one past its last.
+    std::map<uint32_t, uint32_t> m_ranges;
+};
+
+} // namespace LC3::Language
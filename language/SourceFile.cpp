@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <util/CharClass.h>
+#include <util/CharScan.h>
+#include "SourceFile.h"
+
+namespace LC3::Language {
+
+using Util::CharClass;
+using Util::StringView;
+
+static thread_local const SourceFile* t_activeFile = nullptr;
+
+namespace {
+
+struct IncludedFile {
+    std::string name;
+    uint32_t baseOffset = 0;
+    std::unique_ptr<SourceFile> file;
+};
+
+} // namespace
+
+// Kept in order of their base offsets. An entry does not change while it
+// is in the list, and the range a removed one leaves is reused. Entries are
+// shared, so that one being resolved outlives its removal.
+static std::mutex s_includedMutex;
+static std::vector<std::shared_ptr<const IncludedFile>> s_includedFiles;
+
+void SourceFile::buildLineIndex() const {
+    static constexpr CharClass isNewline{ "\n"_sv };
+
+    assert(m_text.size() <= MaxSize);
+
+    const char* textStart = m_text.data();
+    const char* textEnd = textStart + m_text.size();
+
+    m_lineStarts.push_back(0);
+
+    for (const char* curr = textStart; curr != textEnd; ++curr) {
+        curr = Util::CharScan::FindFirst(curr, textEnd, isNewline, true);
+
+        if (curr == textEnd) break;
+
+        m_lineStarts.push_back(static_cast<uint32_t>(curr + 1 - textStart));
+    }
+}
+
+SourceFile::Position SourceFile::position(SourceLocation loc) const {
+    // Parse and encode threads report diagnostics against the same file.
+    std::call_once(m_lineIndexBuilt, [this]() { buildLineIndex(); });
+
+    size_t offset = std::min<size_t>(loc.offset, m_text.size());
+
+    // The last line start that is not past the offset. A linebreak belongs
+    // to the line it terminates.
+    auto lineIter = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset) - 1;
+    size_t lineStart = *lineIter;
+    size_t lineEnd = (lineIter + 1 != m_lineStarts.end()) ?
+                        *(lineIter + 1) - 1 :
+                        m_text.size();
+    Position pos;
+
+    pos.lineNum = static_cast<size_t>(lineIter - m_lineStarts.begin()) + 1;
+    pos.lineOffset = offset - lineStart;
+    pos.line = m_text.subString(lineStart, lineEnd - lineStart);
+
+    return pos;
+}
+
+const SourceFile* SourceFile::active() {
+    return t_activeFile;
+}
+
+void SourceFile::addInclude(std::string path, std::shared_ptr<const void> file) const {
+    std::lock_guard<std::mutex> lock(m_includesMutex);
+
+    m_includes.emplace_back(std::move(path), std::move(file));
+}
+
+std::vector<std::string> SourceFile::includes() const {
+    std::lock_guard<std::mutex> lock(m_includesMutex);
+    std::vector<std::string> paths;
+
+    for (const auto& include : m_includes) {
+        if (std::find(paths.begin(), paths.end(), include.first) == paths.end()) {
+            paths.push_back(include.first);
+        }
+    }
+    return paths;
+}
+
+std::optional<uint32_t> SourceFile::addIncluded(std::string name, StringView text) {
+    std::lock_guard<std::mutex> lock(s_includedMutex);
+
+    // The first gap that fits, with one past the end left over for the End
+    // token.
+    uint64_t rangeSize = text.size() + 1;
+    uint64_t baseOffset = IncludeOffset;
+    auto next = s_includedFiles.begin();
+
+    for (; next != s_includedFiles.end(); ++next) {
+        if ((*next)->baseOffset >= baseOffset + rangeSize) break;
+
+        baseOffset = (*next)->baseOffset + (*next)->file->text().size() + 1;
+    }
+    if (baseOffset + rangeSize > uint64_t{ 1 } << 32) {
+        return std::nullopt;
+    }
+    auto included = std::make_shared<IncludedFile>();
+    included->name = std::move(name);
+    included->baseOffset = static_cast<uint32_t>(baseOffset);
+    included->file = std::make_unique<SourceFile>(text);
+
+    s_includedFiles.insert(next, std::move(included));
+
+    return static_cast<uint32_t>(baseOffset);
+}
+
+void SourceFile::removeIncluded(uint32_t baseOffset) {
+    std::lock_guard<std::mutex> lock(s_includedMutex);
+
+    auto iter = std::find_if(s_includedFiles.begin(), s_includedFiles.end(),
+                             [baseOffset](const std::shared_ptr<const IncludedFile>& file) {
+                                 return file->baseOffset == baseOffset;
+                             });
+    if (iter != s_includedFiles.end()) {
+        s_includedFiles.erase(iter);
+    }
+}
+
+// Finds the file that a location lies in, and the location within it. If it
+// is an included file, its entry is held in included for as long as the
+// file is used.
+static const SourceFile* Resolve(SourceLocation& loc,
+                                 std::shared_ptr<const IncludedFile>& included)
+{
+    if (loc.offset < SourceFile::IncludeOffset) {
+        return SourceFile::active();
+    }
+    {
+        std::lock_guard<std::mutex> lock(s_includedMutex);
+
+        auto iter = std::upper_bound(s_includedFiles.begin(), s_includedFiles.end(), loc.offset,
+                                     [](uint32_t offset,
+                                        const std::shared_ptr<const IncludedFile>& file) {
+                                         return offset < file->baseOffset;
+                                     });
+        if (iter == s_includedFiles.begin()) {
+            return nullptr;
+        }
+        included = *(iter - 1);
+    }
+    loc.offset -= included->baseOffset;
+
+    return included->file.get();
+}
+
+std::optional<SourceFile::Position> SourceFile::find(SourceLocation loc) {
+    std::shared_ptr<const IncludedFile> included;
+    const SourceFile* srcFile = Resolve(loc, included);
+
+    if (srcFile == nullptr) {
+        return std::nullopt;
+    }
+    return srcFile->position(loc);
+}
+
+SourceFile::Scope::Scope(const SourceFile& srcFile) :
+  m_prevFile{ t_activeFile }
+{
+    t_activeFile = &srcFile;
+}
+
+SourceFile::Scope::~Scope() {
+    t_activeFile = m_prevFile;
+}
+
+std::ostream& operator << (std::ostream& outStream, SourceLocation loc) {
+    std::shared_ptr<const IncludedFile> included;
+    const SourceFile* srcFile = Resolve(loc, included);
+
+    if (srcFile == nullptr) {
+        return (outStream << "[@" << loc.offset << ']');
+    }
+    auto pos = srcFile->position(loc);
+
+    outStream << '[';
+
+    if (included) {
+        outStream << included->name << ":";
+    }
+    return (outStream << pos.lineNum << ":" << pos.lineOffset << ']');
+}
+
+void Locate(Log::Diagnostic& diag, SourceLocation loc) {
+    std::shared_ptr<const IncludedFile> included;
+    const SourceFile* srcFile = Resolve(loc, included);
+
+    diag.offset = loc.offset;
+
+    if (srcFile == nullptr) {
+        return;
+    }
+    auto pos = srcFile->position(loc);
+
+    diag.lineNum = static_cast<uint32_t>(pos.lineNum);
+    diag.column = static_cast<uint32_t>(pos.lineOffset);
+    diag.sourceLine.assign(pos.line.data(), pos.line.size());
+
+    if (included) {
+        diag.file = included->name;
+    }
+}
+
+} // namespace LC3::Language
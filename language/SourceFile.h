@@ -0,0 +1,116 @@
+#include <iostream>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <util/StringView.h>
+#include <Log.h>
+#include "SourceLocation.h"
+
+#pragma once
+
+namespace LC3::Language {
+
+class SourceFile {
+public:
+    // Locations from IncludeOffset on belong to files brought in with
+    // .INCLUDE, each of which is given a range of them of its own.
+    static constexpr uint32_t IncludeOffset = uint32_t{ 1 } << 31;
+    static constexpr size_t MaxSize = IncludeOffset - 1;
+
+    struct Position {
+        size_t lineNum = 0;
+        size_t lineOffset = 0;
+        Util::StringView line;
+    };
+
+    // Relative paths named by .INCLUDE are resolved against directory, or
+    // against the working directory if it is empty.
+    SourceFile(Util::StringView text, std::string directory = {}) :
+      m_text{ text },
+      m_directory{ std::move(directory) }
+    {}
+
+    SourceFile(const SourceFile& other) = delete;
+    SourceFile& operator = (const SourceFile& other) = delete;
+
+    Util::StringView text() const {
+        return m_text;
+    }
+
+    const std::string& directory() const {
+        return m_directory;
+    }
+
+    // Records a file brought in with .INCLUDE, by its canonical path, and
+    // keeps it loaded for as long as this file lives, since the statements
+    // parsed from it point into its text. Safe to call from any number of
+    // threads.
+    void addInclude(std::string path, std::shared_ptr<const void> file) const;
+
+    // The paths of the files added so far, each once.
+    std::vector<std::string> includes() const;
+
+    // Maps a location to its line number, column and line text. The table
+    // of line starts is built by the first call, from whichever thread
+    // makes it.
+    Position position(SourceLocation loc) const;
+
+    // Diagnostics resolve token locations against the source file that is
+    // active on the current thread. A Scope makes a file active for as long
+    // as it lives.
+    static const SourceFile* active();
+
+    // Registers the text of an included file and returns the offset its
+    // locations start at, or nothing once the locations are used up.
+    // Diagnostics resolve locations in its range against it, under name,
+    // rather than against the active file.
+    static std::optional<uint32_t> addIncluded(std::string name, Util::StringView text);
+
+    // Gives back the locations of the included file registered at
+    // baseOffset, for files added later to reuse. Nothing may point into
+    // its text anymore.
+    static void removeIncluded(uint32_t baseOffset);
+
+    // Maps a location to its position in the active file or, past
+    // IncludeOffset, in the included file it lies in. Returns nothing if
+    // there is no such file.
+    static std::optional<Position> find(SourceLocation loc);
+
+    class Scope {
+    public:
+        Scope(const SourceFile& srcFile);
+        ~Scope();
+
+        Scope(const Scope& other) = delete;
+        Scope& operator = (const Scope& other) = delete;
+
+    private:
+        const SourceFile* m_prevFile;
+    };
+
+private:
+    void buildLineIndex() const;
+
+    Util::StringView m_text;
+    std::string m_directory;
+    mutable std::vector<uint32_t> m_lineStarts;
+    mutable std::once_flag m_lineIndexBuilt;
+
+    mutable std::mutex m_includesMutex;
+    mutable std::vector<std::pair<std::string, std::shared_ptr<const void>>> m_includes;
+};
+
+// Prints "[line:column]" for the location, resolved against the active file,
+// or "[name:line:column]" if it lies in an included file.
+std::ostream& operator << (std::ostream& outStream, SourceLocation loc);
+
+// Fills in where a diagnostic points: the location's offset, line, column
+// and line text, and the name of the file if it was included.
+void Locate(Log::Diagnostic& diag, SourceLocation loc);
+
+} // namespace LC3::Language
@@ -1,39 +1,14 @@
-#include <iostream>
-#include <cstddef>
-#include <util/StringView.h>
+#include <cstdint>
 
 #pragma once
 
 namespace LC3::Language {
 
+// A position within a source text, stored as a byte offset from its start.
+// Line and column numbers are only worked out when a diagnostic needs them
+// (see SourceFile).
 struct SourceLocation {
-    Util::StringView src;
-    size_t lineNum = 0;
-    size_t lineOffset = 0;
-    size_t absOffset = 0;
-
-    Util::StringView getLine() const {
-        auto lineStart = src.begin() + absOffset;
-
-        while (*lineStart != '\n' && lineStart != src.begin()) {
-            --lineStart;
-        }
-        if (*lineStart == '\n') {
-            ++lineStart;
-        }
-        auto lineEnd = src.begin() + absOffset;
-
-        while (*lineEnd != '\n' && lineEnd != src.end()) {
-            ++lineEnd;
-        }
-        return { lineStart, lineEnd };
-    }
+    uint32_t offset = 0;
 };
 
-inline std::ostream& operator << (std::ostream& outStream, const SourceLocation& loc) {
-    outStream << '[' << loc.lineNum << ":" << loc.lineOffset << ']';
-
-    return outStream;
-}
-
 } // namespace LC3::Language
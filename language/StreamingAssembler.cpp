@@ -0,0 +1,270 @@
+#include <utility>
+#include <vector>
+#include <Log.h>
+#include <util/ParseState.h>
+#include "keywords/Directives.h"
+#include "Tokenizer.h"
+#include "TokenBuffer.h"
+#include "ParserContext.h"
+#include "Grammar.h"
+#include "Parser.h"
+#include "TreeNodes.h"
+#include "TreeAnalyzer.h"
+#include "SymbolTable.h"
+#include "ProgramCounter.h"
+#include "SectionMap.h"
+#include "Encoder.h"
+#include "StreamingAssembler.h"
+
+namespace LC3::Language {
+
+using Keywords::Directive;
+using Util::ParseState;
+
+namespace {
+
+// Lexes a source and parses it a batch of whole lines at a time.
+class StatementReader {
+public:
+    StatementReader(StringView src, SymbolInterner& symbols) :
+      m_tokenizer{ src },
+      m_symbols{ symbols }
+    {}
+
+    // Parses the next batch into stmts. Returns false once the source is
+    // used up or a batch fails to parse.
+    bool next(std::vector<SyntaxTreeNode>& stmts);
+
+    bool failed() const {
+        return m_failed;
+    }
+
+private:
+    Tokenizer m_tokenizer;
+    SymbolInterner& m_symbols;
+
+    bool m_isDone = false;
+    bool m_failed = false;
+};
+
+struct Section {
+    LC3::Word origin;
+    size_t length = 0;
+    Token token;
+};
+
+} // namespace
+
+bool StatementReader::next(std::vector<SyntaxTreeNode>& stmts) {
+    if (m_isDone) {
+        return false;
+    }
+    std::vector<Token> tokens;
+
+    for (; m_tokenizer; ++m_tokenizer) {
+        tokens.push_back(*m_tokenizer);
+
+        if (tokens.size() >= StreamingAssembler::TokenBatchSize &&
+            tokens.back().type == TokenType::Linebreak)
+        {
+            ++m_tokenizer;
+            break;
+        }
+    }
+    if (!m_tokenizer) {
+        tokens.push_back(*m_tokenizer);
+        m_isDone = true;
+    }
+    ParserContext context{ TokenBuffer{ std::move(tokens) }, m_symbols };
+
+    if (Grammar::Document::parse(context) != ParseState::Success ||
+        !Parser::expandIncludes(context.tree.treeTop(), m_symbols))
+    {
+        m_isDone = true;
+        m_failed = true;
+
+        return false;
+    }
+    stmts = std::move(context.tree.treeTop().children);
+
+    return true;
+}
+
+static bool IsStatement(const SyntaxTreeNode& node) {
+    return node.type == NodeType::Instruction || node.type == NodeType::Directive;
+}
+
+static bool IsDirective(const SyntaxTreeNode& node, Directive dirType) {
+    return node.type == NodeType::Directive && node.data<DirectiveNode>() == dirType;
+}
+
+bool StreamingAssembler::assemble(const SourceFile& srcFile, SymbolInterner& symbols,
+                                  LC3Writer& writer)
+{
+    SymbolTable symTable{ symbols };
+    std::vector<bool> definedSyms;
+    std::vector<Section> sections;
+
+    // The first pass: checking, labels and sections.
+    {
+        Log::Context parseLog;
+        Log::Context checkLog;
+
+        StatementReader reader{ srcFile.text(), symbols };
+        std::vector<SyntaxTreeNode> stmts;
+
+        TreeAnalyzer analyzer;
+        ProgramCounter progCounter;
+        bool analysisStatus = true;
+
+        std::vector<SymbolId> pendingSyms;
+        std::vector<Token> redefinedSyms;
+        std::vector<Token> unaddressedSyms;
+
+        while (true) {
+            {
+                Log::Scope logScope{ parseLog };
+
+                if (!reader.next(stmts)) break;
+            }
+            Log::Scope logScope{ checkLog };
+
+            symTable.grow(symbols.size());
+            definedSyms.resize(symbols.size(), false);
+
+            for (SyntaxTreeNode& node : stmts) {
+                if (node.type == NodeType::LabelDefn) {
+                    SymbolId symbolId = node.data<LabelDefnNode>();
+
+                    if (definedSyms[symbolId]) {
+                        redefinedSyms.push_back(node.token);
+                    } else {
+                        definedSyms[symbolId] = true;
+                        pendingSyms.push_back(symbolId);
+                    }
+                    continue;
+                }
+                if (!IsStatement(node)) continue;
+
+                if (!analyzer.analyzeStatement(node)) {
+                    analysisStatus = false;
+
+                    continue;
+                }
+                progCounter.update(node);
+
+                if (IsDirective(node, Directive::END)) {
+                    if (!pendingSyms.empty()) {
+                        unaddressedSyms.push_back(node.token);
+                    }
+                    continue;
+                }
+                for (SymbolId symbolId : pendingSyms) {
+                    symTable.add(symbolId, progCounter.address());
+                }
+                pendingSyms.clear();
+
+                if (IsDirective(node, Directive::ORIG)) {
+                    sections.push_back({ progCounter.address(), 0, node.token });
+                } else if (!sections.empty()) {
+                    sections.back().length += Encoder::statementSize(node);
+                }
+            }
+        }
+        // As in a sequential run, a syntax error supersedes everything else.
+        Log::merge(parseLog);
+
+        if (reader.failed()) {
+            return false;
+        }
+        {
+            Log::Scope logScope{ checkLog };
+
+            analyzer.finish();
+        }
+        Log::merge(checkLog);
+
+        if (!analysisStatus) {
+            return false;
+        }
+        for (const Token& defnToken : redefinedSyms) {
+            Log::error(defnToken, Log::Code::Symbol) << "Symbol has multiple definitions.\n";
+        }
+        for (const Token& endToken : unaddressedSyms) {
+            Log::error(endToken, Log::Code::Section) << "Label to unaddressed memory.\n";
+        }
+        if (!redefinedSyms.empty() || !unaddressedSyms.empty()) {
+            return false;
+        }
+        SectionMap sectionMap;
+        bool sectionStatus = true;
+
+        for (const Section& section : sections) {
+            if (!sectionMap.add(section.origin, section.length, section.token)) {
+                sectionStatus = false;
+            }
+        }
+        if (!sectionStatus) {
+            return false;
+        }
+    }
+    // The second pass: encoding. The text is known to parse and check by
+    // now, so this only reports what the encoder finds.
+    StatementReader reader{ srcFile.text(), symbols };
+    std::vector<SyntaxTreeNode> stmts;
+
+    TreeAnalyzer analyzer;
+    ProgramCounter progCounter;
+    std::vector<LC3::Word> words;
+    size_t sectionIndex = 0;
+    bool encodeStatus = true;
+
+    while (reader.next(stmts)) {
+        for (SyntaxTreeNode& node : stmts) {
+            if (!IsStatement(node)) continue;
+
+            analyzer.analyzeStatement(node);
+            progCounter.update(node);
+
+            // Written the way LC3Writer::putProgram would.
+            if (IsDirective(node, Directive::ORIG)) {
+                const Section& section = sections[sectionIndex++];
+
+                if (encodeStatus) {
+                    if (sectionIndex == 1 && sections.size() > 1) {
+                        writer.putHeader(sections.size());
+                    }
+                    writer.putWord(section.origin);
+
+                    if (sections.size() > 1) {
+                        writer.putWord(static_cast<LC3::WordValue>(section.length));
+                    }
+                }
+                continue;
+            }
+            bool refsDefined = true;
+
+            for (const SyntaxTreeNode& child : node.children) {
+                if (child.type == NodeType::LabelRef && !definedSyms[child.data<LabelRefNode>()]) {
+                    Log::error(child, Log::Code::Symbol) << "Reference to undefined symbol.\n";
+                    refsDefined = false;
+                }
+            }
+            words.clear();
+
+            if (!refsDefined ||
+                !Encoder::encodeStatement(node, symTable, progCounter, words, 0))
+            {
+                encodeStatus = false;
+            }
+            if (!encodeStatus) continue;
+
+            for (LC3::Word word : words) {
+                writer.putWord(word);
+            }
+        }
+    }
+    return encodeStatus;
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <LC3Writer.h>
+#include "SourceFile.h"
+#include "SymbolInterner.h"
+
+namespace LC3::Language {
+
+// Assembles a source in two passes over its text, holding no more than a
+// batch of its statements at a time. The first pass lexes, parses and
+// checks each batch, and records the address of every label and the extent
+// of every section. The second lexes and parses the text again and encodes
+// each statement straight to the writer. Beyond the labels and sections,
+// memory use does not grow with the source, so a source mapped into memory
+// can be far larger than what the other modes could hold as a tree.
+//
+// The checks are those of the single-pass assembler, but each pass stops at
+// the first kind of error it finds, so a program with errors of several
+// kinds may have fewer reported. References to undefined symbols are found
+// while encoding, and nothing more is written once one is.
+class StreamingAssembler {
+public:
+    // A batch is cut at the first linebreak after this many tokens.
+    static constexpr size_t TokenBatchSize = 4096;
+
+    static bool assemble(const SourceFile& srcFile, SymbolInterner& symbols,
+                         LC3Writer& writer);
+};
+
+} // namespace LC3::Language
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <util/StringView.h>
+
+namespace LC3::Language {
+
+using SymbolId = uint32_t;
+
+// Assigns each distinct label name a dense integer ID, in order of first
+// appearance. Names are hashed once, when the parser meets them; every later
+// pass works with IDs and indexes flat arrays with them.
+class SymbolInterner {
+public:
+    SymbolInterner() {}
+    SymbolInterner(const SymbolInterner& other) = delete;
+    SymbolInterner(SymbolInterner&& other) = default;
+
+    SymbolInterner& operator = (const SymbolInterner& other) = delete;
+    SymbolInterner& operator = (SymbolInterner&& other) = default;
+
+    SymbolId intern(const Util::StringView& symbolName) {
+        auto newId = static_cast<SymbolId>(m_names.size());
+        auto [idIter, inserted] = m_ids.try_emplace(symbolName, newId);
+
+        if (inserted) {
+            m_names.push_back(symbolName);
+        }
+        return idIter->second;
+    }
+
+    size_t size() const {
+        return m_names.size();
+    }
+
+    Util::StringView name(SymbolId symbolId) const {
+        return m_names[symbolId];
+    }
+
+private:
+    std::unordered_map<Util::StringView, SymbolId> m_ids;
+    std::vector<Util::StringView> m_names;
+};
+
+} // namespace LC3::Language
@@ -1,7 +1,7 @@
 #include <cassert>
 #include <utility>
 #include <stack>
-#include <unordered_set>
+#include <vector>
 #include <Log.h>
 #include "keywords/Directives.h"
 #include "NodeType.h"
@@ -13,70 +13,73 @@ namespace LC3::Language {
 
 using Keywords::Directive;
 
-static bool LookupNames(const SyntaxTreeNode& root);
-static std::optional<SymbolTable> PopulateSymbolTable(const SyntaxTreeNode& root);
+static bool LookupNames(const SyntaxTreeNode& root, const SymbolInterner& symbols);
+static std::optional<SymbolTable> PopulateSymbolTable(const SyntaxTreeNode& root,
+                                                      const SymbolInterner& symbols);
 
-std::optional<SymbolTable> SymbolTable::make(const SyntaxTreeNode& root) {
+std::optional<SymbolTable> SymbolTable::make(const SyntaxTreeNode& root,
+                                             const SymbolInterner& symbols)
+{
     assert(root.type == NodeType::Root);
 
-    if (!LookupNames(root)) {
+    if (!LookupNames(root, symbols)) {
         return {};
     }
-    return PopulateSymbolTable(root);
+    return PopulateSymbolTable(root, symbols);
 }
 
-bool LookupNames(const SyntaxTreeNode& root) {
+bool LookupNames(const SyntaxTreeNode& root, const SymbolInterner& symbols) {
     bool retStatus = true;
-    std::unordered_set<StringView> definedSyms;
-    std::vector<const Token*> referencedSyms;
+    std::vector<bool> definedSyms(symbols.size(), false);
+    std::vector<const SyntaxTreeNode*> referencedSyms;
 
     root.walk([&definedSyms, &referencedSyms, &retStatus](const SyntaxTreeNode& node) {
         if (node.type == NodeType::LabelDefn) {
-            StringView symbolName = node.token.str;
+            SymbolId symbolId = node.data<LabelDefnNode>();
 
-            if (definedSyms.find(symbolName) != definedSyms.end()) {
-                Log::error(node) << "Symbol has multiple definitions.\n";
+            if (definedSyms[symbolId]) {
+                Log::error(node, Log::Code::Symbol) << "Symbol has multiple definitions.\n";
                 retStatus = false;
             } else {
-                definedSyms.insert(symbolName);
+                definedSyms[symbolId] = true;
             }
         } else if (node.type == NodeType::LabelRef) {
-            referencedSyms.push_back(&node.token);
+            referencedSyms.push_back(&node);
         }
     });
-    for (const Token* refToken : referencedSyms) {
-        assert(refToken != nullptr);
+    for (const SyntaxTreeNode* refNode : referencedSyms) {
+        assert(refNode != nullptr);
 
-        StringView symbolName = refToken->str;
+        SymbolId symbolId = refNode->data<LabelRefNode>();
 
-        if (definedSyms.find(symbolName) == definedSyms.end()) {
-            Log::error(*refToken) << "Reference to undefined symbol.\n";
+        if (!definedSyms[symbolId]) {
+            Log::error(*refNode, Log::Code::Symbol) << "Reference to undefined symbol.\n";
             retStatus = false;
         }
     }
     return retStatus;
 }
 
-static void PopulateSymbols(std::stack<StringView>& syms, LC3::Word addr, SymbolTable& symTable) {
+static void PopulateSymbols(std::stack<SymbolId>& syms, LC3::Word addr, SymbolTable& symTable) {
     for (; !syms.empty(); syms.pop()) {
-        StringView symName = syms.top();
-
-        symTable.add(symName, addr);
+        symTable.add(syms.top(), addr);
     }
 }
 
-std::optional<SymbolTable> PopulateSymbolTable(const SyntaxTreeNode& root) {
+std::optional<SymbolTable> PopulateSymbolTable(const SyntaxTreeNode& root,
+                                               const SymbolInterner& symbols)
+{
     bool retStatus = true;
-    SymbolTable symTable;
+    SymbolTable symTable{ symbols };
     ProgramCounter progCounter;
-    std::stack<StringView> unresolvedSyms;
+    std::stack<SymbolId> unresolvedSyms;
 
     for (const SyntaxTreeNode& childNode : root.children) {
         progCounter.update(childNode);
 
         switch (childNode.type) {
             case NodeType::LabelDefn:
-                unresolvedSyms.push(childNode.token.str);
+                unresolvedSyms.push(childNode.data<LabelDefnNode>());
                 break;
             case NodeType::Instruction:
                 PopulateSymbols(unresolvedSyms, progCounter.address(), symTable);
@@ -85,7 +88,7 @@ std::optional<SymbolTable> PopulateSymbolTable(const SyntaxTreeNode& root) {
                 Directive dirType = childNode.data<DirectiveNode>();
 
                 if (dirType == Directive::END && !unresolvedSyms.empty()) {
-                    Log::error(childNode) << "Label to unaddressed memory.\n";
+                    Log::error(childNode, Log::Code::Section) << "Label to unaddressed memory.\n";
                     retStatus = false;
 
                     break;
@@ -1,56 +1,64 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstddef>
 #include <optional>
+#include <vector>
 #include <lc3/Word.h>
 #include <util/StringView.h>
+#include "SymbolInterner.h"
+#include "SyntaxTreeNode.h"
 
 namespace LC3::Language {
 
 using Util::StringView;
 
+// Maps interned symbols to their addresses. Lookups index a flat array by
+// SymbolId rather than hashing the symbol's name.
 class SymbolTable {
-    using table_type = std::unordered_map<StringView, LC3::Word>;
-
 public:
-    using iterator = table_type::const_iterator;
-
-    SymbolTable() {}
+    SymbolTable(const SymbolInterner& symbols) :
+      m_symbols{ &symbols },
+      m_addrs(symbols.size())
+    {}
     SymbolTable(const SymbolTable& other) = delete;
     SymbolTable(SymbolTable&& other) = default;
 
     SymbolTable& operator = (const SymbolTable& other) = delete;
     SymbolTable& operator = (SymbolTable&& other) = default;
 
-    void add(const StringView& symbolName, LC3::Word addr) {
-        m_table[symbolName] = addr;
+    void add(SymbolId symbolId, LC3::Word addr) {
+        m_addrs[symbolId] = addr;
     }
 
-    bool has(const StringView& symbolName) const {
-        return m_table.find(symbolName) != m_table.end();
+    bool has(SymbolId symbolId) const {
+        return m_addrs[symbolId].has_value();
     }
 
-    std::optional<LC3::Word> get(const StringView& symbolName) const {
-        auto symIter = m_table.find(symbolName);
-        
-        if (symIter != m_table.end()) {
-            return { symIter->second };
-        }
-        return { std::nullopt };
+    std::optional<LC3::Word> get(SymbolId symbolId) const {
+        return m_addrs[symbolId];
     }
 
-    iterator begin() const {
-        return m_table.begin();
+    size_t size() const {
+        return m_addrs.size();
+    }
+
+    // Makes room for symbols interned after the table was created.
+    void grow(size_t numSymbols) {
+        if (numSymbols > m_addrs.size()) {
+            m_addrs.resize(numSymbols);
+        }
     }
 
-    iterator end() const {
-        return m_table.end();
+    StringView name(SymbolId symbolId) const {
+        return m_symbols->name(symbolId);
     }
 
-    static std::optional<SymbolTable> make(const SyntaxTreeNode& root);
+    static std::optional<SymbolTable> make(const SyntaxTreeNode& root,
+                                           const SymbolInterner& symbols);
 
 private:
-    table_type m_table;
+    const SymbolInterner* m_symbols;
+    std::vector<std::optional<LC3::Word>> m_addrs;
 };
 
 } // namespace LC3::Language
@@ -79,8 +79,8 @@ struct SyntaxTreeNode {
         return this != &other;
     }
 
-    std::ostream& errorPrefix(std::ostream& errStream) const {
-        return token.errorPrefix(errStream);
+    void locate(Log::Diagnostic& diag) const {
+        token.locate(diag);
     }
 
 protected:
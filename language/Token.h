@@ -1,19 +1,21 @@
 #include <iostream>
-#include <iomanip>
+#include <cstdint>
 #include <stdexcept>
 #include <util/StringView.h>
 #include "SourceLocation.h"
+#include "SourceFile.h"
 
 #pragma once
 
 namespace LC3::Language {
 
-enum class TokenType {
+enum class TokenType : uint8_t {
     Comma,
     Period,
     Pound,
     Colon,
     Minus,
+    Equals,
     Word,
     Number,
     String,
@@ -22,16 +24,14 @@ enum class TokenType {
     Unknown
 };
 
+// Members are ordered largest first, so the only padding is at the end.
 struct Token {
-    TokenType type = TokenType::Unknown;
     Util::StringView str;
     SourceLocation location;
+    TokenType type = TokenType::Unknown;
 
-    std::ostream& errorPrefix(std::ostream& errStream) const {
-        errStream << location << "\n" << location.getLine() << "\n"
-                  << std::setw(location.lineOffset + 1) << "^" << "\n";
-
-        return errStream;
+    void locate(Log::Diagnostic& diag) const {
+        Locate(diag, location);
     }
 };
 
@@ -47,6 +47,7 @@ inline std::ostream& operator << (std::ostream& outStream, TokenType tokenType)
         CASE(Pound);
         CASE(Colon);
         CASE(Minus);
+        CASE(Equals);
         CASE(Word);
         CASE(Number);
         CASE(String);
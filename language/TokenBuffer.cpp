@@ -0,0 +1,33 @@
+#include <utility>
+#include "Tokenizer.h"
+#include "TokenBuffer.h"
+
+namespace LC3::Language {
+
+TokenBuffer::TokenBuffer(Util::StringView src, uint32_t baseOffset) {
+    Tokenizer tokenizer{ src, baseOffset };
+
+    for (; tokenizer; ++tokenizer) {
+        m_tokens.push_back(*tokenizer);
+    }
+    // Keep the End token so that lookahead past the last real token is
+    // always well-defined.
+    m_tokens.push_back(*tokenizer);
+}
+
+TokenBuffer::TokenBuffer(std::vector<Token>&& tokens) :
+  m_tokens{ std::move(tokens) }
+{
+    if (m_tokens.empty() || m_tokens.back().type != TokenType::End) {
+        SourceLocation endLocation;
+
+        if (!m_tokens.empty()) {
+            const Token& lastToken = m_tokens.back();
+            endLocation.offset = lastToken.location.offset +
+                                 static_cast<uint32_t>(lastToken.str.size());
+        }
+        m_tokens.push_back({ {}, endLocation, TokenType::End });
+    }
+}
+
+} // namespace LC3::Language
@@ -0,0 +1,74 @@
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <util/StringView.h>
+#include "Token.h"
+
+#pragma once
+
+namespace LC3::Language {
+
+// Holds every token of a source text in a contiguous array. The source is
+// lexed exactly once, up front, after which the buffer acts as a cursor
+// with constant-time lookahead. The final token is always an End token.
+class TokenBuffer {
+public:
+    TokenBuffer(Util::StringView src, uint32_t baseOffset = 0);
+
+    // Takes tokens that were lexed elsewhere. An End token is appended,
+    // located just past the last one, unless they already end with one.
+    TokenBuffer(std::vector<Token>&& tokens);
+
+    bool isDone() const {
+        return m_tokens[m_position].type == TokenType::End;
+    }
+    explicit operator bool () const {
+        return !isDone();
+    }
+
+    size_t position() const {
+        return m_position;
+    }
+    size_t size() const {
+        return m_tokens.size();
+    }
+
+    void consume(size_t numTokens = 1) {
+        m_position = clamp(m_position + numTokens);
+    }
+
+    TokenBuffer& operator += (size_t numSteps) {
+        consume(numSteps);
+
+        return *this;
+    }
+
+    TokenBuffer& operator ++ () {
+        return (*this += 1);
+    }
+
+    const Token& peek() const {
+        return m_tokens[m_position];
+    }
+    const Token& peek(size_t numSkips) const {
+        return m_tokens[clamp(m_position + numSkips)];
+    }
+
+    const Token& operator * () const {
+        return peek();
+    }
+
+    const Token& operator [] (size_t index) const {
+        return m_tokens[clamp(index)];
+    }
+
+private:
+    size_t clamp(size_t index) const {
+        return index < m_tokens.size() ? index : m_tokens.size() - 1;
+    }
+
+    std::vector<Token> m_tokens;
+    size_t m_position = 0;
+};
+
+} // namespace LC3::Language
@@ -1,5 +1,4 @@
 #include <stdexcept>
-#include <cctype>
 #include <cassert>
 #include <util/CharClass.h>
 #include <util/StringView.h>
@@ -12,39 +11,30 @@ using Util::CharClass;
 using Util::StringView;
 using Util::StringTokenizer;
 
-static const CharClass isPunct(".,#:-");
-static const CharClass isQuote("'\"");
-static const CharClass isComment(";");
-static const CharClass isNewline("\n");
-static const CharClass isSpace = ~isNewline & CharClass([](char c) -> bool {
-    auto cu = static_cast<unsigned char>(c);
-
-    return std::isspace(cu) != 0;
-});
-static const CharClass isAlpha([](char c) -> bool {
-    auto cu = static_cast<unsigned char>(c);
-
-    return std::isalpha(cu) != 0;
-});
-static const CharClass isDecDigit("0123456789");
-static const CharClass isHexDigit("0123456789abcdefABCDEF");
-static const CharClass isAlnum = isAlpha | isDecDigit;
-static const CharClass isWord = isAlnum | CharClass("_");
-static const CharClass isEnd("\0"_sv);
+static constexpr CharClass isPunct{ ".,#:-="_sv };
+static constexpr CharClass isQuote{ "'\""_sv };
+static constexpr CharClass isComment{ ";"_sv };
+static constexpr CharClass isNewline{ "\n"_sv };
+static constexpr CharClass isSpace{ " \t\v\f\r"_sv };
+static constexpr CharClass isAlpha = CharClass::between('a', 'z') | CharClass::between('A', 'Z');
+static constexpr CharClass isDecDigit = CharClass::between('0', '9');
+static constexpr CharClass isHexDigit = isDecDigit | CharClass{ "abcdefABCDEF"_sv };
+static constexpr CharClass isAlnum = isAlpha | isDecDigit;
+static constexpr CharClass isWord = isAlnum | CharClass{ "_"_sv };
+static constexpr CharClass isEnd{ "\0"_sv };
 
 Token Tokenizer::getToken() {
     StringTokenizer& tokenizer = m_tokenizer;
     char nextChar = tokenizer.peekChar();
 
-    if (isSpace(nextChar)) {
-        tokenizer.skipUntilNot(isSpace);
-
-        return getToken();
-    }
-    if (isComment(nextChar)) {
-        tokenizer.skipUntil(isNewline);
-
-        return getToken();
+    // Skip any run of whitespace and comments that precedes the token.
+    while (isSpace(nextChar) || isComment(nextChar)) {
+        if (isComment(nextChar)) {
+            tokenizer.skipUntil(isNewline);
+        } else {
+            tokenizer.skipUntilNot(isSpace);
+        }
+        nextChar = tokenizer.peekChar();
     }
     StringView tokenStr;
     auto tokenType = TokenType::Unknown;
@@ -53,9 +43,6 @@ Token Tokenizer::getToken() {
     if (isNewline(nextChar)) {
         tokenStr = tokenizer.read(1);
         tokenType = TokenType::Linebreak;
-
-        ++m_lineNum;
-        m_lineStart = tokenizer.currIter();
     } else if (isPunct(nextChar)) {
         tokenStr = tokenizer.read(1);
 
@@ -75,6 +62,9 @@ Token Tokenizer::getToken() {
             case '-':
                 tokenType = TokenType::Minus;
                 break;
+            case '=':
+                tokenType = TokenType::Equals;
+                break;
             default:
                 throw std::domain_error("Unimplemented token-punctuation case.");
         }
@@ -119,7 +109,7 @@ Token Tokenizer::getToken() {
         tokenStr = tokenizer.read(1);
         tokenType = TokenType::Unknown;
     }
-    return { tokenType, tokenStr, tokenLocation };
+    return { tokenStr, tokenLocation, tokenType };
 }
 
 } // namespace LC3::Language
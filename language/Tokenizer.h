@@ -1,5 +1,6 @@
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
 #include <util/StringView.h>
 #include <util/StringTokenizer.h>
 #include "SourceLocation.h"
@@ -22,12 +23,14 @@ public:
 
     Tokenizer(const Tokenizer& other) = default;
     Tokenizer(Tokenizer&& other) = default;
-    Tokenizer(Util::StringView src) :
-      Tokenizer(src.begin(), src.end())
+    // Token locations are offset by baseOffset, so that a slice of a larger
+    // source reports positions within the whole.
+    Tokenizer(Util::StringView src, uint32_t baseOffset = 0) :
+      Tokenizer(src.begin(), src.end(), baseOffset)
     {}
-    Tokenizer(SrcIter startIter, SrcIter endIter) :
+    Tokenizer(SrcIter startIter, SrcIter endIter, uint32_t baseOffset = 0) :
       m_tokenizer{ startIter, endIter },
-      m_lineStart{ startIter }
+      m_baseOffset{ baseOffset }
     {
         // Assign m_currToken with the first token
         consume(1);
@@ -90,17 +93,11 @@ private:
     Token getToken();
 
     SourceLocation getLocation() const {
-        Util::StringView src(m_tokenizer.startIter(), m_tokenizer.endIter());
-        size_t lineOffset = m_tokenizer.currIter() - m_lineStart;
-        size_t absOffset = m_tokenizer.currIter() - m_tokenizer.startIter();
-
-        return { src, m_lineNum, lineOffset, absOffset };
+        return { m_baseOffset + static_cast<uint32_t>(m_tokenizer.position()) };
     }
 
     Util::StringTokenizer m_tokenizer;
-
-    SrcIter m_lineStart;
-    size_t m_lineNum = 1;
+    uint32_t m_baseOffset = 0;
 
     bool m_isDone = false;
 
@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <Log.h>
 #include <util/StringView.h>
 #include <util/GenericParser.h>
 #include <util/ParseState.h>
 #include "TreeNodes.h"
 #include "keywords/Instructions.h"
+#include "keywords/InstructionForms.h"
 #include "keywords/Directives.h"
 #include "NodeType.h"
 #include "TreeAnalyzer.h"
@@ -13,14 +15,10 @@ namespace LC3::Language {
 using Util::StringView;
 using Util::ParseState;
 using Keywords::Instruction;
+using Keywords::InstructionForm;
+using Keywords::InstructionForms;
 using Keywords::Directive;
 
-struct AnalyzerFlags {
-    bool addressedMemory = false;
-    bool seenOrigDirective = false;
-    bool terminateCheck = false;
-};
-
 static bool AnalyzeTreeNode(SyntaxTreeNode& node, AnalyzerFlags& flags);
 static bool AnalyzeInstruction(SyntaxTreeNode& node, AnalyzerFlags& flags);
 static bool AnalyzeDirective(SyntaxTreeNode& node, AnalyzerFlags& flags);
@@ -128,6 +126,7 @@ using Number = FormatSpec<NodeFormat::Num, Num>;
 using Address = FormatSpec<NodeFormat::Addr, Addr>;
 using String = FormatSpec<NodeFormat::Str, Str>;
 using Branch = FormatSpec<NodeFormat::Branch, BrFlags, Addr>;
+using Symbol = FormatSpec<NodeFormat::Label, Label>;
 using Vector = FormatSpec<NodeFormat::Vec, Num>;
 
 using NumNum = FormatSpec<NodeFormat::NumNum, Num, Num>;
@@ -143,24 +142,36 @@ using RegRegReg = FormatSpec<NodeFormat::RegRegReg, Reg, Reg, Reg>;
 template <typename... SpecTs>
 static NodeFormat CheckNode(const SyntaxTreeNode& node);
 
-bool TreeAnalyzer::analyze(SyntaxTreeNode& root) {
-    bool status = true;
-    AnalyzerFlags flags;
+static bool CheckFormat(CheckerContext& ctx, const SyntaxTreeNode& node, NodeFormat format);
+static void PrintFormat(std::ostream& outStream, NodeFormat format);
 
-    root.walk([&status, &flags](SyntaxTreeNode& node) {
-        if (flags.terminateCheck) return;
+bool TreeAnalyzer::analyze(SyntaxTreeNode& root, bool allowExternals, bool allowLiterals) {
+    bool status = true;
+    TreeAnalyzer analyzer{ allowExternals, allowLiterals };
 
-        if (!AnalyzeTreeNode(node, flags)) {
+    root.walk([&status, &analyzer](SyntaxTreeNode& node) {
+        if (!analyzer.analyzeStatement(node)) {
             status = false;
         }
     });
-    if (flags.addressedMemory) {
-        Log::warning() << "Unmatched .ORIG directive. Did you forget "
-                       << "to put .END at the end of the file?\n";
-    }
+    analyzer.finish();
+
     return status;
 }
 
+bool TreeAnalyzer::analyzeStatement(SyntaxTreeNode& node) {
+    if (m_flags.terminateCheck) return true;
+
+    return AnalyzeTreeNode(node, m_flags);
+}
+
+void TreeAnalyzer::finish() {
+    if (m_flags.addressedMemory) {
+        Log::warning(Log::Code::Section) << "Unmatched .ORIG directive. Did you forget "
+                                         << "to put .END at the end of the file?\n";
+    }
+}
+
 bool AnalyzeTreeNode(SyntaxTreeNode& node, AnalyzerFlags& flags) {
     switch (node.type) {
         case NodeType::Instruction:
@@ -177,64 +188,68 @@ static NodeFormat GetInstructionFormat(const SyntaxTreeNode& node) {
     assert(node.type == NodeType::Instruction);
 
     const auto& instrData = node.data<InstructionNode>();
+    auto forms = InstructionForms::of(instrData.type);
 
-    switch (instrData.type) {
-    #define I(Ins) Instruction::Ins
-        case I(ADD):
-            return CheckNode<RegRegNum, RegRegReg>(node);
-        case I(AND):
-            return CheckNode<RegRegNum, RegRegReg>(node);
-        case I(BR):
-            return CheckNode<Branch>(node);
-        case I(JMP):
-            return CheckNode<Address>(node);
-        case I(JSR):
-            return CheckNode<Address>(node);
-        case I(JSRR):
-            return CheckNode<Register>(node);
-        case I(LD):
-            return CheckNode<RegAddr>(node);
-        case I(LDI):
-            return CheckNode<RegAddr>(node);
-        case I(LDR):
-            return CheckNode<RegRegAddr>(node);
-        case I(LEA):
-            return CheckNode<RegAddr>(node);
-        case I(NOT):
-            return CheckNode<RegReg>(node);
-        case I(RET):
-            return CheckNode<Empty>(node);
-        case I(RTI):
-            return CheckNode<Empty>(node);
-        case I(ST):
-            return CheckNode<RegAddr>(node);
-        case I(STI):
-            return CheckNode<RegAddr>(node);
-        case I(STR):
-            return CheckNode<RegRegAddr>(node);
-        case I(TRAP):
-            return CheckNode<Vector>(node);
-        case I(GETC):
-        case I(PUTS):
-        case I(PUTSP):
-        case I(OUT):
-        case I(IN):
-        case I(HALT):
-            return CheckNode<Empty>(node);
-        default:
-            break;
-    #undef I
+    if (forms.empty()) {
+        return NodeFormat::Invalid;
+    }
+    CheckerContext ctx;
+
+    for (const InstructionForm& form : forms) {
+        if (CheckFormat(ctx, node, form.format)) {
+            return form.format;
+        }
+    }
+    auto& err = Log::error(node, Log::Code::Syntax);
+
+    err << "No matching format found. Valid formats are:\n";
+
+    for (const InstructionForm& form : forms) {
+        PrintFormat(err, form.format);
+        err << "\n";
     }
+    err << "\n";
+
     return NodeFormat::Invalid;
 }
 
+static bool HasLiteral(const SyntaxTreeNode& node) {
+    return std::any_of(node.children.begin(), node.children.end(),
+                       [](const SyntaxTreeNode& child) { return child.type == NodeType::Literal; });
+}
+
+// Literals are not part of any instruction form, since they turn into a
+// plain LD once their pool is placed.
+static bool AnalyzeLiteralLoad(SyntaxTreeNode& node, const AnalyzerFlags& flags) {
+    auto& instrData = node.data<InstructionNode>();
+
+    if (instrData.type != Instruction::LD || node.children.size() != 2 ||
+        node.child(0).type != NodeType::Register || node.child(1).type != NodeType::Literal)
+    {
+        Log::error(node, Log::Code::Syntax) << "Only LD can load a literal, as in LD R0, =x1234.\n";
+
+        return false;
+    }
+    if (!flags.allowLiterals) {
+        Log::error(node.child(1), Log::Code::Syntax) << "Literals can only be used when assembling a program "
+                                                     << "with the multi-pass assembler.\n";
+        return false;
+    }
+    instrData.format = NodeFormat::RegAddr;
+
+    return true;
+}
+
 bool AnalyzeInstruction(SyntaxTreeNode& node, AnalyzerFlags& flags) {
     if (!flags.addressedMemory) {
-        Log::error(node) << "Instruction in unaddressed memory.\n"
-                         << "Use the .ORIG and .END directives to "
-                         << "designate an addressed region of memory.\n";
+        Log::error(node, Log::Code::Section) << "Instruction in unaddressed memory.\n"
+                                             << "Use the .ORIG and .END directives to "
+                                             << "designate an addressed region of memory.\n";
         return false;
     }
+    if (HasLiteral(node)) {
+        return AnalyzeLiteralLoad(node, flags);
+    }
     NodeFormat instrFormat = GetInstructionFormat(node);
 
     if (instrFormat == NodeFormat::Invalid) {
@@ -250,8 +265,14 @@ bool AnalyzeDirective(SyntaxTreeNode& node, AnalyzerFlags& flags) {
     Directive dirType = node.data<DirectiveNode>();
     NodeFormat nodeFormat = NodeFormat::Invalid;
 
-    if (!flags.addressedMemory && dirType != Directive::ORIG) {
-        auto& err = Log::error(node);
+    bool isDeclaration = dirType == Directive::EXTERNAL || dirType == Directive::GLOBAL;
+
+    // Parser expands every .INCLUDE, so one that is left has malformed
+    // operands, wherever it is.
+    bool isInclude = dirType == Directive::INCLUDE;
+
+    if (!flags.addressedMemory && dirType != Directive::ORIG && !isDeclaration && !isInclude) {
+        auto& err = Log::error(node, Log::Code::Section);
 
         if (dirType != Directive::END) {
             err << "Memory allocation in unaddressed memory."
@@ -266,20 +287,12 @@ bool AnalyzeDirective(SyntaxTreeNode& node, AnalyzerFlags& flags) {
     #define D(Dir) Directive::Dir
         case D(ORIG):
             if (flags.addressedMemory) {
-                Log::error(node) << "Nested .ORIG directives is not allowed.\n";
-
-                return false;
-            }
-            if (flags.seenOrigDirective) {
-                Log::error(node) << "Multiple .ORIG statements within a single file "
-                                 << "is not supported.\n";
-                flags.terminateCheck = true;
+                Log::error(node, Log::Code::Section) << "Nested .ORIG directives is not allowed.\n";
 
                 return false;
             }
             nodeFormat = CheckNode<Number>(node);
             flags.addressedMemory = true;
-            flags.seenOrigDirective = true;
             break;
         case D(FILL):
             nodeFormat = CheckNode<Address>(node);
@@ -294,6 +307,20 @@ bool AnalyzeDirective(SyntaxTreeNode& node, AnalyzerFlags& flags) {
             nodeFormat = CheckNode<Empty>(node);
             flags.addressedMemory = false;
             break;
+        case D(EXTERNAL):
+            if (!flags.allowExternals) {
+                Log::error(node, Log::Code::Symbol) << "External symbols can only be used when assembling "
+                                                    << "a relocatable object.\n";
+                return false;
+            }
+            nodeFormat = CheckNode<Symbol>(node);
+            break;
+        case D(GLOBAL):
+            nodeFormat = CheckNode<Symbol>(node);
+            break;
+        case D(INCLUDE):
+            nodeFormat = CheckNode<String>(node);
+            break;
         case D(Invalid):
             throw std::logic_error("Encountered invalid directive node.");
     #undef D
@@ -342,7 +369,7 @@ NodeFormat CheckNode(const SyntaxTreeNode& node) {
     CheckerContext ctx;
 
     if (!(CheckNodeSingle<SpecTs>(ctx, node) || ...)) {
-        auto& err = Log::error(node);
+        auto& err = Log::error(node, Log::Code::Syntax);
 
         err << "No matching format found. Valid formats are:\n";
         PrintSpecs<SpecTs...>(err);
@@ -351,4 +378,50 @@ NodeFormat CheckNode(const SyntaxTreeNode& node) {
     return ctx.format;
 }
 
+// Calls func with the spec of a format, or returns false if it has none.
+template <typename FuncT>
+static bool VisitSpec(NodeFormat format, FuncT&& func) {
+    switch (format) {
+    #define F(Format, Spec) \
+        case NodeFormat::Format: \
+            func(Spec{}); \
+            return true;
+        F(Empty, Empty)
+        F(Reg, Register)
+        F(Num, Number)
+        F(Str, String)
+        F(Addr, Address)
+        F(Label, Symbol)
+        F(Branch, Branch)
+        F(Vec, Vector)
+        F(NumNum, NumNum)
+        F(NumAddr, NumAddr)
+        F(RegReg, RegReg)
+        F(RegNum, RegNum)
+        F(RegAddr, RegAddr)
+        F(RegRegReg, RegRegReg)
+        F(RegRegNum, RegRegNum)
+        F(RegRegAddr, RegRegAddr)
+    #undef F
+        case NodeFormat::Invalid:
+            break;
+    }
+    return false;
+}
+
+bool CheckFormat(CheckerContext& ctx, const SyntaxTreeNode& node, NodeFormat format) {
+    bool matched = false;
+
+    VisitSpec(format, [&](auto spec) {
+        matched = CheckNodeSingle<decltype(spec)>(ctx, node);
+    });
+    return matched;
+}
+
+void PrintFormat(std::ostream& outStream, NodeFormat format) {
+    VisitSpec(format, [&](auto spec) {
+        PrintSpec<decltype(spec)>(outStream);
+    });
+}
+
 } // namespace LC3::Language
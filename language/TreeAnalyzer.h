@@ -4,9 +4,42 @@
 
 namespace LC3::Language {
 
+struct AnalyzerFlags {
+    bool addressedMemory = false;
+    bool terminateCheck = false;
+
+    // Whether symbols may be imported from other modules with .EXTERNAL,
+    // which only works when assembling a relocatable object.
+    bool allowExternals = false;
+
+    // Whether LD may load a literal, which only works when the literal
+    // pools are placed before encoding.
+    bool allowLiterals = false;
+};
+
 class TreeAnalyzer {
 public:
-    static bool analyze(SyntaxTreeNode& root);
+    explicit TreeAnalyzer(bool allowExternals = false, bool allowLiterals = false) {
+        m_flags.allowExternals = allowExternals;
+        m_flags.allowLiterals = allowLiterals;
+    }
+
+    static bool analyze(SyntaxTreeNode& root, bool allowExternals = false,
+                        bool allowLiterals = false);
+
+    // Checks a single top-level statement. This lets other passes fold
+    // analysis into their own walk over the tree. Call finish() once every
+    // statement has been seen.
+    bool analyzeStatement(SyntaxTreeNode& node);
+    void finish();
+
+    // Set once an error was found that makes checking the rest pointless.
+    bool terminated() const {
+        return m_flags.terminateCheck;
+    }
+
+private:
+    AnalyzerFlags m_flags;
 };
 
 } // namespace LC3::Language
@@ -6,6 +6,7 @@
 #include <lc3/Word.h>
 #include "SyntaxTreeNode.h"
 #include "NodeFormat.h"
+#include "SymbolInterner.h"
 #include "keywords/Instructions.h"
 #include "keywords/Directives.h"
 
@@ -47,6 +48,18 @@ struct DirectiveNode :
     static size_t size(const SyntaxTreeNode& node);
 };
 
+struct LabelDefnNode :
+    public NodeBase<NodeType::LabelDefn, SymbolId>
+{
+    using NodeBase::NodeBase;
+};
+
+struct LabelRefNode :
+    public NodeBase<NodeType::LabelRef, SymbolId>
+{
+    using NodeBase::NodeBase;
+};
+
 struct RegisterNode :
     public NodeBase<NodeType::Register, LC3::Word>
 {
@@ -67,6 +80,14 @@ struct StringNode :
     static size_t size(const SyntaxTreeNode& node);
 };
 
+// A constant for LD to load from a literal pool, written =value or =LABEL.
+// Its only child is the Number or LabelRef it stands for.
+struct LiteralNode : public SyntaxTreeNode {
+    explicit LiteralNode(const Token& token) :
+      SyntaxTreeNode(NodeType::Literal, token)
+    {}
+};
+
 struct BRFlagsData {
     bool n = false;
     bool z = false;
@@ -1,20 +1,28 @@
+#include <util/KeywordTable.h>
 #include "Directives.h"
 
 namespace LC3::Language::Keywords {
 
-const KeywordMap<enum Directive> Directives::DirMap = {
+using Util::KeywordTable;
+
+using DirTable = KeywordTable<enum Directive, 0
+    #define _(Name) + 1
+    #include "Directives.str"
+    #undef _
+>;
+
+static constexpr DirTable::Entry DirEntries[] = {
     #define _(Name) { #Name ##_sv, Directive::Name },
     #include "Directives.str"
     #undef _
 };
 
+static constexpr DirTable DirMap{ DirEntries };
+
 enum Directive Directives::get(const StringView& dirName) {
-    auto setIter = DirMap.find(dirName);
+    const Directive* dirType = DirMap.find(dirName);
 
-    if (setIter != DirMap.end()) {
-        return setIter->second;
-    }
-    return Directive::Invalid;
+    return dirType != nullptr ? *dirType : Directive::Invalid;
 }
 
 std::ostream& operator << (std::ostream& outStream, Directive dir) {
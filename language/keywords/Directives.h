@@ -3,12 +3,10 @@
 #include <iostream>
 #include <lc3/Word.h>
 #include <util/StringView.h>
-#include <util/KeywordMap.h>
 
 namespace LC3::Language::Keywords {
 
 using Util::StringView;
-using Util::KeywordMap;
 
 enum class Directive {
     #define _(Name) Name,
@@ -19,8 +17,6 @@ enum class Directive {
 };
 
 class Directives {
-    static const KeywordMap<enum Directive> DirMap;
-
 public:
     static bool has(const StringView& dirName) {
         return get(dirName) != Directive::Invalid;
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <lc3/Word.h>
+#include <language/NodeFormat.h>
+#include "Instructions.h"
+
+namespace LC3::Language::Keywords {
+
+// What an operand's field in an instruction word holds.
+enum class OperandKind : uint8_t {
+    None,
+    Reg,        // A register number.
+    Flags,      // The n, z and p flags of a branch.
+    Imm,        // A signed immediate.
+    Offset,     // A signed offset from a base register.
+    PcOffset,   // A signed offset from the address of the next instruction.
+    Vector      // An unsigned trap vector.
+};
+
+struct OperandField {
+    OperandKind kind = OperandKind::None;
+    uint8_t shift = 0;
+    uint8_t width = 0;
+
+    constexpr WordValue mask() const {
+        return static_cast<WordValue>(((1u << width) - 1) << shift);
+    }
+};
+
+// One way of encoding an instruction, as listed in InstructionForms.str.
+struct InstructionForm {
+    static constexpr size_t MaxOperands = 3;
+
+    Instruction instr;
+    NodeFormat format;
+
+    // The opcode together with any other bits the form fixes.
+    WordValue bits;
+
+    std::array<OperandField, MaxOperands> operands;
+
+    // The bits of a word that hold the operands. The rest must match bits.
+    constexpr WordValue operandMask() const {
+        WordValue mask = 0;
+
+        for (const OperandField& field : operands) {
+            mask |= field.mask();
+        }
+        return mask;
+    }
+
+    constexpr bool isPcRelative() const {
+        for (const OperandField& field : operands) {
+            if (field.kind == OperandKind::PcOffset) return true;
+        }
+        return false;
+    }
+};
+
+namespace Internals {
+
+constexpr OperandField None() {
+    return {};
+}
+
+constexpr OperandField Reg(uint8_t shift) {
+    return { OperandKind::Reg, shift, 3 };
+}
+
+constexpr OperandField Flags(uint8_t shift) {
+    return { OperandKind::Flags, shift, 3 };
+}
+
+constexpr OperandField Imm(uint8_t shift, uint8_t width) {
+    return { OperandKind::Imm, shift, width };
+}
+
+constexpr OperandField Offset(uint8_t shift, uint8_t width) {
+    return { OperandKind::Offset, shift, width };
+}
+
+constexpr OperandField PcOffset(uint8_t shift, uint8_t width) {
+    return { OperandKind::PcOffset, shift, width };
+}
+
+constexpr OperandField Vector(uint8_t shift, uint8_t width) {
+    return { OperandKind::Vector, shift, width };
+}
+
+inline constexpr InstructionForm FormTable[] = {
+    #define _(Name, Format, Bits, First, Second, Third) \
+        { Instruction::Name, NodeFormat::Format, \
+          static_cast<WordValue>(static_cast<WordValue>(Instruction::Name) | (Bits)), \
+          { First, Second, Third } },
+    #include "InstructionForms.str"
+    #undef _
+};
+
+constexpr size_t NumForms = sizeof(FormTable) / sizeof(FormTable[0]);
+
+constexpr size_t FirstForm(Instruction instr) {
+    size_t index = 0;
+
+    while (index < NumForms && FormTable[index].instr != instr) {
+        ++index;
+    }
+    return index;
+}
+
+#define _(Name, Opcode) \
+    static_assert(FirstForm(Instruction::Name) < NumForms, "No form encodes " #Name ".");
+#include "Instructions.str"
+#undef _
+
+} // namespace Internals
+
+// The operand layouts of the instructions. A single table, generated from
+// InstructionForms.str, tells the analyzer which operands each instruction
+// takes, the encoder where they go in the word, and the decoder how to
+// read them back, so that none of them can disagree with the others.
+class InstructionForms {
+public:
+    // The forms of one instruction, which are next to each other in the
+    // table.
+    class Range {
+    public:
+        constexpr Range(const InstructionForm* first, const InstructionForm* last) :
+          m_first{ first },
+          m_last{ last }
+        {}
+
+        constexpr const InstructionForm* begin() const { return m_first; }
+        constexpr const InstructionForm* end() const { return m_last; }
+        constexpr bool empty() const { return m_first == m_last; }
+
+    private:
+        const InstructionForm* m_first;
+        const InstructionForm* m_last;
+    };
+
+    static constexpr Range all() {
+        return { Internals::FormTable, Internals::FormTable + Internals::NumForms };
+    }
+
+    // The forms of instr, in the order the parser tries them. There are none
+    // for Instruction::Invalid.
+    static constexpr Range of(Instruction instr) {
+        size_t first = Internals::NumForms;
+
+        // Resolved at compile time for each instruction, leaving a switch on
+        // the opcode.
+        switch (instr) {
+            #define _(Name, Opcode) \
+                case Instruction::Name: \
+                    first = std::integral_constant<size_t, \
+                                                   Internals::FirstForm(Instruction::Name)>::value; \
+                    break;
+            #include "Instructions.str"
+            #undef _
+
+            default:
+                break;
+        }
+        size_t last = first;
+
+        while (last < Internals::NumForms && Internals::FormTable[last].instr == instr) {
+            ++last;
+        }
+        return { Internals::FormTable + first, Internals::FormTable + last };
+    }
+
+    // The form of instr with the given operand format, or null if there is
+    // none.
+    static constexpr const InstructionForm* find(Instruction instr, NodeFormat format) {
+        for (const InstructionForm& form : of(instr)) {
+            if (form.format == format) return &form;
+        }
+        return nullptr;
+    }
+};
+
+} // namespace LC3::Language::Keywords
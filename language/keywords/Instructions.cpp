@@ -1,69 +1,48 @@
-#include <cctype>
-#include <util/StringUtils.h>
+#include <util/KeywordTable.h>
 #include "Instructions.h"
 
 namespace LC3::Language::Keywords {
 
 using Util::StringView;
-using Util::Str::CaselessCompare;
+using Util::KeywordTable;
 
-const KeywordMap<enum Instruction> Instructions::InstrMap = {
+// A special case in the LC3 grammar is the BR instruction. The BR
+// instruction has a variable number of flags that are specified in the
+// instruction's name, in any order but each at most once. Every such
+// spelling gets its own table entry.
+#define BRANCH_VARIANTS \
+    B(n) B(z) B(p) \
+    B(nz) B(zn) B(np) B(pn) B(zp) B(pz) \
+    B(nzp) B(npz) B(znp) B(zpn) B(pnz) B(pzn)
+
+using InstrTable = KeywordTable<enum Instruction, 0
+    #define _(Name, Opcode) + 1
+    #include "Instructions.str"
+    #undef _
+
+    #define B(Flags) + 1
+    BRANCH_VARIANTS
+    #undef B
+>;
+
+static constexpr InstrTable::Entry InstrEntries[] = {
     #define _(Name, Opcode) { #Name ##_sv, Instruction::Name },
     #include "Instructions.str"
     #undef _
-};
 
-struct BranchFlags {
-    bool n = false;
-    bool z = false;
-    bool p = false;
+    #define B(Flags) { "BR" #Flags ""_sv, Instruction::BR },
+    BRANCH_VARIANTS
+    #undef B
 };
 
-static bool IsBranchInstruction(const StringView& strVal) {
-    if (!strVal.beginsWith("BR", CaselessCompare())) {
-        return false;
-    }
-    BranchFlags seenFlags;
-
-    for (char c : strVal.subString(2)) {
-        switch (std::tolower(c)) {
-            case 'n':
-                if (seenFlags.n) {
-                    return false;
-                }
-                seenFlags.n = true;
-                break;
-            case 'z':
-                if (seenFlags.z) {
-                    return false;
-                }
-                seenFlags.z = true;
-                break;
-            case 'p':
-                if (seenFlags.p) {
-                    return false;
-                }
-                seenFlags.p = true;
-                break;
-            default:
-                return false;
-        }
-    }
-    return true;
-}
+#undef BRANCH_VARIANTS
+
+static constexpr InstrTable InstrMap{ InstrEntries };
 
 enum Instruction Instructions::get(const StringView& instrName) {
-    auto mapIter = InstrMap.find(instrName);
-
-    if (mapIter == InstrMap.end()) {
-        // A special case in the LC3 grammar is the BR instruction.
-        // The BR instruction has a variable number of flags that
-        // are specified in the instruction's name.
-        return IsBranchInstruction(instrName) ?
-            Instruction::BR :
-            Instruction::Invalid;
-    }
-    return mapIter->second;
+    const Instruction* instrType = InstrMap.find(instrName);
+
+    return instrType != nullptr ? *instrType : Instruction::Invalid;
 }
 
 LC3::Word Instructions::getOpcode(const StringView& instrName) {
@@ -3,12 +3,10 @@
 #include <iostream>
 #include <lc3/Word.h>
 #include <util/StringView.h>
-#include <util/KeywordMap.h>
 
 namespace LC3::Language::Keywords {
 
 using Util::StringView;
-using Util::KeywordMap;
 
 enum class Instruction : LC3::Word::value_type {
     #define _(Name, Opcode) Name = Opcode,
@@ -19,8 +17,6 @@ enum class Instruction : LC3::Word::value_type {
 };
 
 class Instructions {
-    static const KeywordMap<enum Instruction> InstrMap;
-
 public:
     static bool has(const StringView& instrName) {
         return get(instrName) != Instruction::Invalid;
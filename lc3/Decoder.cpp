@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <vector>
+#include "Decoder.h"
+
+namespace LC3 {
+
+using Language::Keywords::InstructionForms;
+
+static size_t CountBits(WordValue value) {
+    size_t count = 0;
+
+    for (; value != 0; value &= static_cast<WordValue>(value - 1)) {
+        ++count;
+    }
+    return count;
+}
+
+const std::array<uint8_t, Decoder::TableSize>& Decoder::table() {
+    static_assert(InstructionForms::all().end() - InstructionForms::all().begin() < NoForm,
+                  "Too many instruction forms for a byte-sized index.");
+
+    static const auto s_table = []() {
+        std::array<uint8_t, TableSize> table;
+        std::vector<uint8_t> order;
+
+        table.fill(NoForm);
+
+        const InstructionForm* forms = InstructionForms::all().begin();
+
+        for (const InstructionForm& form : InstructionForms::all()) {
+            order.push_back(static_cast<uint8_t>(&form - forms));
+        }
+        // Some instructions are special cases of others: RET is a JMP and
+        // HALT is a TRAP. Forms with fewer operand bits are filled in last,
+        // so that the special cases win.
+        std::stable_sort(order.begin(), order.end(), [forms](uint8_t lhs, uint8_t rhs) {
+            return CountBits(forms[lhs].operandMask()) > CountBits(forms[rhs].operandMask());
+        });
+        for (uint8_t index : order) {
+            const InstructionForm& form = forms[index];
+            WordValue mask = form.operandMask();
+
+            // Every combination of the operand bits, from all set to none.
+            for (WordValue operands = mask;; operands = static_cast<WordValue>((operands - 1) & mask)) {
+                table[static_cast<WordValue>(form.bits | operands)] = index;
+
+                if (operands == 0) break;
+            }
+        }
+        // A branch with no flags set never branches, so it is not taken for
+        // an instruction. Among others, this leaves zeroed memory as data.
+        for (WordValue offset = 0; offset <= 0x1FF; ++offset) {
+            table[offset] = NoForm;
+        }
+        return table;
+    }();
+
+    return s_table;
+}
+
+} // namespace LC3
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <lc3/Word.h>
+#include <language/keywords/InstructionForms.h>
+
+namespace LC3 {
+
+// Maps every possible word to the instruction form it encodes, through a
+// table with an entry for each of the 64K words. The table is built once,
+// from the forms in InstructionForms.str, the first time it is needed.
+//
+// Words that no form encodes, including ones with nonzero bits where the
+// instruction set wants zeros and branches with no flags set, are data.
+class Decoder {
+public:
+    using InstructionForm = Language::Keywords::InstructionForm;
+
+    static constexpr size_t TableSize = size_t{ 1 } << Word::numBits;
+
+    // The form word encodes, or null if it is data.
+    static const InstructionForm* decode(Word word) {
+        uint8_t index = table()[word.value()];
+
+        return index != NoForm ? &Language::Keywords::InstructionForms::all().begin()[index] : nullptr;
+    }
+
+private:
+    static constexpr uint8_t NoForm = 0xFF;
+
+    // Each entry is an index into the form table, which keeps the whole
+    // table at 64 KiB.
+    static const std::array<uint8_t, TableSize>& table();
+};
+
+} // namespace LC3
@@ -1,46 +1,172 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <filesystem>
+#include <optional>
 #include <lc3/Word.h>
 #include <Log.h>
 #include <LC3Writer.h>
+#include <AssemblyCache.h>
+#include <AssemblyServer.h>
+#include <ObjectFile.h>
 #include <util/StringView.h>
+#include <util/ThreadPool.h>
+#include <util/FileWatcher.h>
+#include <util/MappedFile.h>
+#include <language/SourceFile.h>
+#include <language/SymbolInterner.h>
 #include <language/Parser.h>
 #include <language/TreeAnalyzer.h>
 #include <language/SymbolTable.h>
 #include <language/Encoder.h>
+#include <language/Optimizer.h>
+#include <language/Relaxer.h>
+#include <language/LiteralPools.h>
+#include <language/Assembler.h>
+#include <language/PipelinedAssembler.h>
+#include <language/StreamingAssembler.h>
+#include <language/IncrementalAssembler.h>
+#include <language/ObjectAssembler.h>
+#include <language/Listing.h>
 
 using Util::StringView;
 
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
 using LC3::Language::Parser;
 using LC3::Language::TreeAnalyzer;
 using LC3::Language::SymbolTable;
 using LC3::Language::Encoder;
+using LC3::Language::Optimizer;
+using LC3::Language::Relaxer;
+using LC3::Language::LiteralPools;
+using LC3::Language::Assembler;
+using LC3::Language::PipelinedAssembler;
+using LC3::Language::StreamingAssembler;
+using LC3::Language::IncrementalAssembler;
+using LC3::Language::ObjectAssembler;
+using LC3::Language::Listing;
 
-int Run(int argc, char** argv);
+enum class Mode {
+    SinglePass,
+
+    // Runs the analyzer, symbol table and encoder as separate passes.
+    MultiPass,
+
+    // Runs the lexer, parser and single-pass assembler concurrently as a
+    // pipeline, without building the whole tree.
+    Pipelined,
+
+    // Makes two passes over the input mapped into memory, parsing a batch
+    // of lines at a time, so memory use only grows with the labels.
+    Streaming
+};
+
+struct Options {
+    Mode mode = Mode::SinglePass;
+
+    // Writes a relocatable object for lc3ld instead of a program.
+    bool relocatable = false;
+
+    // Runs the peephole optimizer between making the symbol table and
+    // encoding, so it always takes the multi-pass route.
+    bool optimize = false;
+
+    // Rewrites branches and loads whose labels are out of reach into longer
+    // sequences that reach them, after any optimizing.
+    bool relax = false;
+
+    // Batch mode: every filename is an input, and each output is written
+    // to this directory under the input's name with an .obj extension.
+    StringView outputDir;
+
+    // Number of threads to use: files assembled at once in batch mode, or
+    // chunks of a single large source parsed at once otherwise. Zero picks
+    // one per hardware thread.
+    size_t numJobs = 0;
+
+    // Upper bound on the threads one source may be split across while it
+    // is parsed and, in multi-pass mode, encoded.
+    size_t threadsPerFile = 1;
+
+    // Keeps running, reassembling the input each time it is saved.
+    bool watch = false;
+
+    // Reuses the output of an earlier run on the same source, if one is in
+    // the assembly cache.
+    bool useCache = true;
+
+    // Also writes a listing (.lst) and a symbol map (.sym) next to each
+    // output. Only the single-pass assembler can produce them.
+    bool listing = false;
+    bool symbols = false;
+
+    // Sends single-pass assemblies to the server listening on this socket,
+    // taken from LC3ASM_SERVER. If it cannot be reached, the input is
+    // assembled here as usual.
+    std::string serverPath;
+
+    // How diagnostics are written to standard error.
+    Log::Format diagnosticsFormat = Log::Format::Text;
+
+    // The input that diagnostics about the main source are attributed to in
+    // JSON, when a single file is assembled.
+    std::string inputName;
+};
+
+int Run(int argc, char** argv, Options& options);
+int RunBatch(const std::vector<StringView>& inputFilenames, const Options& options);
+int RunWatch(StringView inputFilename, StringView outputFilename, const Options& options);
+int AssembleFile(StringView inputFilename, StringView outputFilename, const Options& options);
 std::string GetSourceText(std::istream& inStream);
-int Assemble(const std::string& src, LC3Writer& writer);
+bool MayInclude(const std::string& src);
+bool MayUseLiterals(const std::string& src);
+int Assemble(const std::string& src, LC3Writer& writer, const Options& options);
+int AssembleObject(const std::string& src, StringView outputFilename);
+int AssembleWithMaps(const std::string& src, StringView outputFilename, const Options& options);
+int StreamFile(StringView inputFilename, StringView outputFilename);
 
+void PrintSummary(std::ostream& outStream, size_t numErrors, size_t numWarnings);
 void PrintCount(std::ostream& outStream, size_t count, const StringView& name);
 
 int main(int argc, char** argv) {
-    int ret = Run(argc, argv);
+    Options options;
+    int ret = Run(argc, argv, options);
 
-    if (Log::errorCount() > 0) {
-        std::cerr << "Assembly failed with ";
-        PrintCount(std::cerr, Log::errorCount(), "error");
+    Log::flush(std::cerr, options.diagnosticsFormat, options.inputName);
 
-        std::cerr << " and ";
-        PrintCount(std::cerr, Log::warningCount(), "warning");
-        std::cerr << ".\n";
-    } else if (Log::warningCount() > 0) {
-        std::cerr << "Assembly succeeded with ";
-        PrintCount(std::cerr, Log::warningCount(), "warning");
-        std::cerr << ".\n";
+    if (options.diagnosticsFormat == Log::Format::Text) {
+        PrintSummary(std::cerr, Log::errorCount(), Log::warningCount());
     }
+
     return ret;
 }
 
+void PrintSummary(std::ostream& outStream, size_t numErrors, size_t numWarnings) {
+    if (numErrors > 0) {
+        outStream << "Assembly failed with ";
+        PrintCount(outStream, numErrors, "error");
+
+        outStream << " and ";
+        PrintCount(outStream, numWarnings, "warning");
+        outStream << ".\n";
+    } else if (numWarnings > 0) {
+        outStream << "Assembly succeeded with ";
+        PrintCount(outStream, numWarnings, "warning");
+        outStream << ".\n";
+    }
+}
+
 void PrintCount(std::ostream& outStream, size_t count, const StringView& name) {
     outStream << count << " " << name;
 
@@ -49,19 +175,330 @@ void PrintCount(std::ostream& outStream, size_t count, const StringView& name) {
     }
 }
 
-int Run(int argc, char** argv) {
-    if (argc < 3) {
-        Log::error() << "Incorrect number of arguments.\n"
-                     << "Usage: lc3asm input_file output_file\n";
+int Run(int argc, char** argv, Options& options) {
+    std::vector<StringView> filenames;
+    std::string listenPath;
+
+    if (const char* serverPath = std::getenv("LC3ASM_SERVER")) {
+        options.serverPath = serverPath;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        StringView arg = argv[i];
+
+        if (arg == "--multi-pass") {
+            options.mode = Mode::MultiPass;
+        } else if (arg == "--pipeline") {
+            options.mode = Mode::Pipelined;
+        } else if (arg == "--stream") {
+            options.mode = Mode::Streaming;
+        } else if (arg == "--watch") {
+            options.watch = true;
+        } else if (arg == "--no-cache") {
+            options.useCache = false;
+        } else if (arg == "--listing") {
+            options.listing = true;
+        } else if (arg == "--symbols") {
+            options.symbols = true;
+        } else if (arg == "-c") {
+            options.relocatable = true;
+        } else if (arg == "-O") {
+            options.optimize = true;
+        } else if (arg == "--relax") {
+            options.relax = true;
+        } else if (arg == "-j" || arg == "-o" || arg == "--server" ||
+                   arg == "--max-errors" || arg == "--diagnostics-format")
+        {
+            if (i + 1 == argc) {
+                Log::error(Log::Code::Usage) << "Option " << arg << " requires an argument.\n";
+
+                return 1;
+            }
+            StringView value = argv[++i];
+
+            if (arg == "-o") {
+                options.outputDir = value;
+
+                continue;
+            }
+            if (arg == "--server") {
+                listenPath.assign(value.data(), value.size());
+
+                continue;
+            }
+            if (arg == "--diagnostics-format") {
+                if (value == "text") {
+                    options.diagnosticsFormat = Log::Format::Text;
+                } else if (value == "json") {
+                    options.diagnosticsFormat = Log::Format::JsonLines;
+                } else {
+                    Log::error(Log::Code::Usage) << "Unknown diagnostics format " << value << ".\n";
+
+                    return 1;
+                }
+                continue;
+            }
+            size_t count = 0;
+
+            try {
+                count = std::stoul(std::string{ value.data(), value.size() });
+            } catch (const std::exception&) {
+                Log::error(Log::Code::Usage) << "Invalid " << (arg == "-j" ? "job" : "error")
+                                             << " count " << value << ".\n";
+                return 1;
+            }
+            if (arg == "-j") {
+                options.numJobs = count;
+            } else {
+                Log::setMaxErrors(count);
+            }
+        } else if (arg.beginsWith("-") && arg != "-") {
+            Log::error(Log::Code::Usage) << "Unknown option " << arg << ".\n";
+
+            return 1;
+        } else {
+            filenames.push_back(arg);
+        }
+    }
+    if (!listenPath.empty()) {
+        if (!filenames.empty()) {
+            Log::error(Log::Code::Usage) << "Option --server takes no input files.\n";
+
+            return 1;
+        }
+        size_t numThreads = options.numJobs;
+
+        if (numThreads == 0) {
+            numThreads = std::thread::hardware_concurrency();
+        }
+        AssemblyServer::serve(listenPath, numThreads);
+
+        Log::error(Log::Code::IO) << "Unable to listen on " << listenPath << ".\n";
+
+        return 1;
+    }
+    if (options.listing || options.symbols) {
+        StringView mapOption = options.listing ? "--listing" : "--symbols";
+
+        if (options.mode != Mode::SinglePass || options.relocatable || options.watch) {
+            Log::error(Log::Code::Usage) << "Option " << mapOption << " only works with the single-pass assembler.\n";
+
+            return 1;
+        }
+    }
+    if (options.optimize || options.relax) {
+        const char* rewriteOption = options.optimize ? "-O" : "--relax";
+
+        if (options.mode == Mode::Pipelined || options.mode == Mode::Streaming) {
+            Log::error(Log::Code::Usage) << "Option " << rewriteOption << " cannot be used with --pipeline or --stream.\n";
+
+            return 1;
+        }
+        if (options.relocatable || options.watch || options.listing || options.symbols) {
+            Log::error(Log::Code::Usage) << "Option " << rewriteOption << " only works when assembling a program.\n";
+
+            return 1;
+        }
+    }
+    if (options.outputDir.size() > 0) {
+        if (options.watch) {
+            Log::error(Log::Code::Usage) << "Option --watch cannot be used in batch mode.\n";
+
+            return 1;
+        }
+        if (filenames.empty()) {
+            Log::error(Log::Code::Usage) << "No input files.\n";
+
+            return 1;
+        }
+        return RunBatch(filenames, options);
+    }
+    if (filenames.size() != 2) {
+        Log::error(Log::Code::Usage) << "Incorrect number of arguments.\n"
+                                     << "Usage: lc3asm [-c | -O] [--relax] [--multi-pass | --pipeline | --stream] [--no-cache] [-j N] input_file output_file\n"
+                                     << "       lc3asm --watch input_file output_file\n"
+                                     << "       lc3asm --server socket_path [-j N]\n"
+                                     << "       lc3asm [-c | -O] [--relax] [--multi-pass | --pipeline | --stream] [--no-cache] [-j N] input_file... -o output_dir\n"
+                                     << "Diagnostics: [--max-errors N] [--diagnostics-format text | json]\n"
+                                     << "Maps: [--listing] [--symbols]\n";
+        return 1;
+    }
+    if (options.watch) {
+        if (options.relocatable) {
+            Log::error(Log::Code::Usage) << "Option --watch cannot be used with -c.\n";
+
+            return 1;
+        }
+        return RunWatch(filenames[0], filenames[1], options);
+    }
+    options.threadsPerFile = options.numJobs;
+
+    if (options.threadsPerFile == 0) {
+        options.threadsPerFile = std::thread::hardware_concurrency();
+    }
+    options.inputName.assign(filenames[0].data(), filenames[0].size());
+
+    return AssembleFile(filenames[0], filenames[1], options);
+}
+
+int RunBatch(const std::vector<StringView>& inputFilenames, const Options& options) {
+    namespace fs = std::filesystem;
+
+    fs::path outputDir{ std::string{ options.outputDir.data(), options.outputDir.size() } };
+    std::error_code ec;
+
+    fs::create_directories(outputDir, ec);
+
+    if (ec) {
+        Log::error(Log::Code::IO) << "Unable to create directory " << options.outputDir
+                                  << ": " << ec.message() << "\n";
         return 1;
     }
+    // Outputs are named after the inputs alone, so two inputs with the same
+    // name in different directories would overwrite each other.
+    std::vector<fs::path> outputPaths;
+    std::map<fs::path, StringView> inputOfOutput;
+
+    for (StringView inputFilename : inputFilenames) {
+        if (inputFilename == "-") {
+            Log::error(Log::Code::Usage) << "Standard input cannot be used in batch mode.\n";
+
+            return 1;
+        }
+        fs::path outputPath = outputDir / fs::path{ inputFilename.data() }.filename();
+        outputPath.replace_extension(options.relocatable ? ".o" : ".obj");
+
+        auto [entry, inserted] = inputOfOutput.try_emplace(outputPath, inputFilename);
+
+        if (!inserted) {
+            Log::error(Log::Code::Usage) << entry->second << " and " << inputFilename << " would both be written to "
+                                         << outputPath.string() << ".\n";
+            return 1;
+        }
+        outputPaths.push_back(std::move(outputPath));
+    }
+    size_t numJobs = options.numJobs;
+
+    if (numJobs == 0) {
+        numJobs = std::thread::hardware_concurrency();
+    }
+    std::mutex outputMutex;
+    std::atomic<bool> anyFailed{ false };
+
+    Util::ThreadPool pool{ std::min(numJobs, inputFilenames.size()) };
+
+    for (size_t i = 0; i < inputFilenames.size(); ++i) {
+        StringView inputFilename = inputFilenames[i];
+
+        pool.submit([&, inputFilename, i]() {
+            Log::Context logContext;
+
+            {
+                Log::Scope logScope{ logContext };
+
+                if (AssembleFile(inputFilename, outputPaths[i].string(), options) != 0) {
+                    anyFailed = true;
+                }
+            }
+            std::ostringstream diagStream;
+
+            if (options.diagnosticsFormat == Log::Format::JsonLines) {
+                logContext.render(diagStream, Log::Format::JsonLines,
+                                  std::string{ inputFilename.data(), inputFilename.size() });
+            } else if (logContext.errorCount() + logContext.warningCount() > 0) {
+                diagStream << inputFilename << ":\n";
+                logContext.render(diagStream, Log::Format::Text);
+                PrintSummary(diagStream, logContext.errorCount(), logContext.warningCount());
+            }
+            std::string diagnostics = diagStream.str();
+
+            if (!diagnostics.empty()) {
+                std::lock_guard<std::mutex> lock(outputMutex);
+
+                std::cerr << diagnostics;
+            }
+        });
+    }
+    pool.wait();
+
+    return anyFailed ? 1 : 0;
+}
+
+int RunWatch(StringView inputFilename, StringView outputFilename, const Options& options) {
+    if (inputFilename == "-") {
+        Log::error(Log::Code::Usage) << "Standard input cannot be watched.\n";
+
+        return 1;
+    }
+    if (!inputFilename.endsWith(".asm")) {
+        Log::error(Log::Code::Usage) << "Input file must end with .asm\n";
+
+        return 1;
+    }
+    Util::FileWatcher watcher{ inputFilename.data() };
+
+    if (!watcher) {
+        Log::error(Log::Code::IO) << "Unable to watch " << inputFilename << ".\n";
+
+        return 1;
+    }
+    IncrementalAssembler assembler;
+    std::string inputName{ inputFilename.data(), inputFilename.size() };
+
+    do {
+        std::ifstream inFile(inputFilename.data());
+
+        if (!inFile) continue;
+
+        std::string src = GetSourceText(inFile);
+        Log::Context logContext;
+        bool assembleStatus = false;
+
+        auto startTime = std::chrono::steady_clock::now();
+        {
+            Log::Scope logScope{ logContext };
+
+            if (src.size() > SourceFile::MaxSize) {
+                Log::error(Log::Code::IO) << "Input file is too large.\n";
+            } else {
+                assembleStatus = assembler.update(std::move(src));
+            }
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime);
+
+        if (assembleStatus) {
+            LC3Writer writer(outputFilename.data());
+
+            writer.putProgram(assembler.image());
+        }
+        logContext.render(std::cerr, options.diagnosticsFormat, inputName);
+
+        if (options.diagnosticsFormat == Log::Format::Text) {
+            PrintSummary(std::cerr, logContext.errorCount(), logContext.warningCount());
+        }
+        std::cout << inputFilename << ": " << (assembleStatus ? "assembled" : "failed")
+                  << " (" << (assembler.wasIncremental() ? "incremental" : "full")
+                  << ", " << elapsed.count() << " us)" << std::endl;
+
+        // Editing an included file reassembles the program too.
+        for (const std::string& includePath : assembler.includes()) {
+            watcher.add(includePath);
+        }
+    } while (watcher.wait());
+
+    return 0;
+}
+
+int AssembleFile(StringView inputFilename, StringView outputFilename, const Options& options) {
+    if (options.mode == Mode::Streaming && !options.relocatable) {
+        return StreamFile(inputFilename, outputFilename);
+    }
     std::string src;
-    StringView inputFilename = argv[1];
-    StringView outputFilename = argv[2];
 
     if (inputFilename != "-") {
         if (!inputFilename.endsWith(".asm")) {
-            Log::error() << "Input file must end with .asm\n";
+            Log::error(Log::Code::Usage) << "Input file must end with .asm\n";
 
             return 1;
         }
@@ -73,9 +510,49 @@ int Run(int argc, char** argv) {
 
         src = GetSourceText(std::cin);
     }
-    LC3Writer writer(outputFilename.data());
+    if (src.size() > SourceFile::MaxSize) {
+        Log::error(Log::Code::IO) << "Input file is too large.\n";
 
-    return Assemble(src, writer);
+        return 1;
+    }
+    std::optional<AssemblyCache> cache;
+    std::string cacheKey;
+
+    // The cache only holds the program, not the maps.
+    if (options.useCache && !options.listing && !options.symbols && !MayInclude(src)) {
+        cache = AssemblyCache::open();
+    }
+    if (cache) {
+        // Only runs that succeed without diagnostics are cached, so of the
+        // options only the kind of output, -O and --relax affect what a run
+        // produced.
+        std::string flags = options.relocatable ? "-c" : options.optimize ? "-O" : "";
+
+        if (options.relax) {
+            flags += flags.empty() ? "--relax" : " --relax";
+        }
+        cacheKey = AssemblyCache::key(src, flags);
+
+        if (cache->fetch(cacheKey, outputFilename.data())) {
+            return 0;
+        }
+    }
+    size_t numDiagnostics = Log::errorCount() + Log::warningCount();
+    int ret = 0;
+
+    if (options.relocatable) {
+        ret = AssembleObject(src, outputFilename);
+    } else if (options.listing || options.symbols) {
+        ret = AssembleWithMaps(src, outputFilename, options);
+    } else {
+        LC3Writer writer(outputFilename.data());
+        ret = Assemble(src, writer, options);
+    }
+
+    if (cache && ret == 0 && Log::errorCount() + Log::warningCount() == numDiagnostics) {
+        cache->store(cacheKey, outputFilename.data());
+    }
+    return ret;
 }
 
 std::string GetSourceText(std::istream& inStream) {
@@ -93,26 +570,224 @@ std::string GetSourceText(std::istream& inStream) {
     return srcStr;
 }
 
-int Assemble(const std::string& src, LC3Writer& writer) {
-    auto asTree = Parser::parse(src);
+// Runs are cached under a hash of the source alone, which would miss a
+// change to a file it includes. A false alarm only costs a cache miss.
+bool MayInclude(const std::string& src) {
+    static constexpr StringView directive = ".include"_sv;
+
+    return std::search(src.begin(), src.end(), directive.begin(), directive.end(),
+                       [](char srcChar, char dirChar) {
+                           return std::tolower(static_cast<unsigned char>(srcChar)) == dirChar;
+                       }) != src.end();
+}
+
+// The server assembles in a single pass, which cannot place literal pools.
+bool MayUseLiterals(const std::string& src) {
+    return src.find('=') != std::string::npos;
+}
+
+int Assemble(const std::string& src, LC3Writer& writer, const Options& options) {
+    bool rewrites = options.optimize || options.relax;
+
+    if (options.mode == Mode::SinglePass && !rewrites && !options.serverPath.empty() &&
+        !MayUseLiterals(src))
+    {
+        std::error_code ec;
+        std::string directory = std::filesystem::current_path(ec).string();
+
+        if (auto result = AssemblyServer::request(options.serverPath, src, directory)) {
+            Log::merge(std::move(result->diagnostics), result->numErrors, result->numWarnings);
+
+            if (!result->succeeded) {
+                return 1;
+            }
+            writer.putProgram(result->image);
+
+            return 0;
+        }
+    }
+    SourceFile srcFile{ src };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+
+    if (options.mode == Mode::Pipelined) {
+        return PipelinedAssembler::assemble(srcFile, symbols, writer) ? 0 : 1;
+    }
+    auto asTree = Parser::parse(srcFile.text(), symbols, options.threadsPerFile);
 
     if (!asTree) {
         return 1;
     }
-    bool analysisStatus = TreeAnalyzer::analyze(*asTree);
+    bool usesLiterals = LiteralPools::used(*asTree);
+
+    if (options.mode == Mode::SinglePass && !rewrites && !usesLiterals) {
+        return Assembler::assemble(*asTree, symbols, writer) ? 0 : 1;
+    }
+    bool analysisStatus = TreeAnalyzer::analyze(*asTree, false, true);
 
     if (!analysisStatus) {
         return 1;
     }
-    auto symTable = SymbolTable::make(*asTree);
+    auto symTable = SymbolTable::make(*asTree, symbols);
 
     if (!symTable) {
         return 1;
     }
-    bool encoderStatus = Encoder::encode(*asTree, *symTable, writer);
+    // The passes below move the labels after whatever they change, so the
+    // table is made again after each one that changes something.
+    auto remakeSymTable = [&]() {
+        symTable = SymbolTable::make(*asTree, symbols);
+
+        return symTable.has_value();
+    };
+    if (options.optimize && Optimizer::optimize(*asTree, *symTable) && !remakeSymTable()) {
+        return 1;
+    }
+    if (options.relax && Relaxer::relax(*asTree, *symTable) && !remakeSymTable()) {
+        return 1;
+    }
+    // Pools go last so the passes above see the layout as written, except
+    // that they can push a branch or load out of reach again.
+    if (usesLiterals && (!LiteralPools::place(*asTree) || !remakeSymTable())) {
+        return 1;
+    }
+    if (options.relax && usesLiterals && Relaxer::relax(*asTree, *symTable) &&
+        !remakeSymTable())
+    {
+        return 1;
+    }
+    bool encoderStatus = Encoder::encode(*asTree, *symTable, writer, options.threadsPerFile);
 
     if (!encoderStatus) {
         return 1;
     }
     return 0;
 }
+
+int AssembleObject(const std::string& src, StringView outputFilename) {
+    SourceFile srcFile{ src };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    auto asTree = Parser::parse(srcFile.text(), symbols);
+    ObjectFile object;
+
+    if (!asTree || !ObjectAssembler::assemble(*asTree, symbols, object)) {
+        return 1;
+    }
+    if (!object.write(outputFilename.data())) {
+        Log::error(Log::Code::IO) << "Unable to write " << outputFilename << ".\n";
+
+        return 1;
+    }
+    return 0;
+}
+
+// The maps are named after the output, with its extension replaced.
+int AssembleWithMaps(const std::string& src, StringView outputFilename, const Options& options) {
+    SourceFile srcFile{ src };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    auto asTree = Parser::parse(srcFile.text(), symbols, options.threadsPerFile);
+
+    if (!asTree) {
+        return 1;
+    }
+    Assembler assembler{ symbols };
+    assembler.recordPlacements();
+
+    for (auto& node : asTree->children) {
+        if (assembler.terminated()) break;
+
+        assembler.add(std::move(node));
+    }
+    std::vector<LC3::Word> image;
+
+    if (!assembler.finish(image)) {
+        return 1;
+    }
+    LC3Writer writer(outputFilename.data());
+
+    if (!writer.putProgram(image)) {
+        return 1;
+    }
+    std::filesystem::path mapPath{ std::string{ outputFilename.data(), outputFilename.size() } };
+
+    if (options.listing) {
+        mapPath.replace_extension(".lst");
+
+        if (!Listing::writeListing(mapPath.c_str(), image, assembler.placements())) {
+            Log::error(Log::Code::IO) << "Unable to write " << mapPath.string() << ".\n";
+
+            return 1;
+        }
+    }
+    if (options.symbols) {
+        mapPath.replace_extension(".sym");
+
+        if (!Listing::writeSymbols(mapPath.c_str(), assembler.symbolTable())) {
+            Log::error(Log::Code::IO) << "Unable to write " << mapPath.string() << ".\n";
+
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// The input is mapped rather than read, so that it never has to fit in
+// memory. Neither the cache nor the server is used, since both need the
+// whole source at once.
+int StreamFile(StringView inputFilename, StringView outputFilename) {
+    if (inputFilename == "-") {
+        Log::error(Log::Code::Usage) << "Standard input cannot be used with --stream.\n";
+
+        return 1;
+    }
+    if (!inputFilename.endsWith(".asm")) {
+        Log::error(Log::Code::Usage) << "Input file must end with .asm\n";
+
+        return 1;
+    }
+    Util::MappedFile inFile{ std::string{ inputFilename.data(), inputFilename.size() } };
+
+    if (!inFile) {
+        Log::error(Log::Code::IO) << "Unable to read " << inputFilename << ".\n";
+
+        return 1;
+    }
+    if (inFile.text().size() > SourceFile::MaxSize) {
+        Log::error(Log::Code::IO) << "Input file is too large.\n";
+
+        return 1;
+    }
+    SourceFile srcFile{ inFile.text() };
+    SourceFile::Scope srcScope{ srcFile };
+
+    // Words go out as they are encoded, so they are streamed into a file
+    // next to the output, which only takes its place once the run succeeds.
+    std::string outputPath{ outputFilename.data(), outputFilename.size() };
+    std::string partialPath = outputPath + ".part";
+
+    SymbolInterner symbols;
+    LC3Writer writer(partialPath.c_str());
+
+    bool status = StreamingAssembler::assemble(srcFile, symbols, writer);
+    writer.close();
+
+    std::error_code ec;
+
+    if (status) {
+        std::filesystem::rename(partialPath, outputPath, ec);
+
+        if (ec) {
+            Log::error(Log::Code::IO) << "Unable to write " << outputFilename << ".\n";
+            status = false;
+        }
+    }
+    if (!status) {
+        std::filesystem::remove(partialPath, ec);
+    }
+    return status ? 0 : 1;
+}
@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <lc3/Word.h>
+#include <lc3/Decoder.h>
+#include <Log.h>
+#include <LC3Format.h>
+#include <LC3Reader.h>
+#include <util/StringView.h>
+#include <util/TextWriter.h>
+
+using Util::StringView;
+using Util::TextWriter;
+
+using LC3::Decoder;
+using LC3::WordValue;
+using LC3::Language::Keywords::Instruction;
+using LC3::Language::Keywords::InstructionForm;
+using LC3::Language::Keywords::OperandField;
+using LC3::Language::Keywords::OperandKind;
+
+using SymbolMap = std::unordered_map<WordValue, std::string>;
+
+int Run(int argc, char** argv);
+bool ReadProgram(StringView inputFilename, std::vector<LC3::Word>& image);
+bool ReadSymbols(StringView symbolFilename, SymbolMap& symbols);
+void Disassemble(TextWriter& writer, const std::vector<LC3::Word>& image, const SymbolMap& symbols);
+
+int main(int argc, char** argv) {
+    int ret = Run(argc, argv);
+
+    Log::flush(std::cerr);
+
+    size_t numErrors = Log::errorCount();
+
+    if (numErrors > 0) {
+        std::cerr << "Disassembly failed with " << numErrors
+                  << (numErrors == 1 ? " error.\n" : " errors.\n");
+    }
+    return ret;
+}
+
+int Run(int argc, char** argv) {
+    std::vector<StringView> inputFilenames;
+    StringView symbolFilename;
+    StringView outputFilename;
+
+    for (int i = 1; i < argc; ++i) {
+        StringView arg = argv[i];
+
+        if (arg == "-o" || arg == "-s") {
+            if (i + 1 == argc) {
+                Log::error(Log::Code::Usage) << "Option " << arg << " requires an argument.\n";
+
+                return 1;
+            }
+            if (arg == "-o") {
+                outputFilename = argv[++i];
+            } else {
+                symbolFilename = argv[++i];
+            }
+        } else if (arg.beginsWith("-")) {
+            Log::error(Log::Code::Usage) << "Unknown option " << arg << ".\n";
+
+            return 1;
+        } else {
+            inputFilenames.push_back(arg);
+        }
+    }
+    if (inputFilenames.size() != 1) {
+        Log::error(Log::Code::Usage) << "Incorrect number of arguments.\n"
+                                     << "Usage: lc3dis [-s symbol_file] input_file [-o output_file]\n";
+        return 1;
+    }
+    StringView inputFilename = inputFilenames[0];
+    std::vector<LC3::Word> image;
+
+    if (!ReadProgram(inputFilename, image)) {
+        return 1;
+    }
+    SymbolMap symbols;
+
+    if (symbolFilename.size() > 0 && !ReadSymbols(symbolFilename, symbols)) {
+        return 1;
+    }
+    std::FILE* outFile = stdout;
+
+    if (outputFilename.size() > 0) {
+        outFile = std::fopen(outputFilename.data(), "w");
+
+        if (outFile == nullptr) {
+            Log::error(Log::Code::IO) << "Unable to open " << outputFilename << " for writing.\n";
+
+            return 1;
+        }
+    }
+    bool writeStatus = false;
+    {
+        TextWriter writer{ outFile };
+
+        Disassemble(writer, image, symbols);
+
+        writeStatus = writer.close();
+    }
+    if (outFile != stdout && std::fclose(outFile) != 0) {
+        writeStatus = false;
+    }
+    if (!writeStatus) {
+        Log::error(Log::Code::IO) << "Unable to write the disassembly.\n";
+
+        return 1;
+    }
+    return 0;
+}
+
+// Reads a program with one section or several into an image, in which each
+// section is its origin and its length followed by its words.
+bool ReadProgram(StringView inputFilename, std::vector<LC3::Word>& image) {
+    LC3Reader reader(inputFilename.data());
+
+    if (!reader) {
+        Log::error(Log::Code::IO) << "Unable to read " << inputFilename << ".\n";
+
+        return false;
+    }
+    if (!reader.getProgram(image)) {
+        Log::error(Log::Code::IO) << inputFilename << " holds no well-formed program.\n";
+
+        return false;
+    }
+    return true;
+}
+
+// Reads a symbol map as lc3asm --symbols writes it, with a line of the
+// form "x3000 LABEL" for each label. The first label at an address wins.
+bool ReadSymbols(StringView symbolFilename, SymbolMap& symbols) {
+    std::ifstream inFile(symbolFilename.data());
+
+    if (!inFile) {
+        Log::error(Log::Code::IO) << "Unable to read " << symbolFilename << ".\n";
+
+        return false;
+    }
+    std::string line;
+    size_t lineNum = 0;
+
+    while (std::getline(inFile, line)) {
+        ++lineNum;
+
+        if (line.empty()) continue;
+
+        const char* lineEnd = line.data() + line.size();
+        uint32_t addr = 0;
+        auto result = std::from_chars(line.data() + 1, lineEnd, addr, 16);
+
+        if (line[0] != 'x' || result.ec != std::errc{} || addr > LC3::Word::maxValue ||
+            result.ptr == lineEnd || *result.ptr != ' ' || result.ptr + 1 == lineEnd)
+        {
+            Log::error(Log::Code::Syntax) << symbolFilename << ":" << lineNum << ": Malformed symbol entry.\n";
+
+            return false;
+        }
+        symbols.try_emplace(static_cast<WordValue>(addr), result.ptr + 1, lineEnd);
+    }
+    return true;
+}
+
+static StringView Mnemonic(Instruction instr) {
+    switch (instr) {
+        #define _(Name, Opcode) \
+            case Instruction::Name: \
+                return #Name ""_sv;
+        #include <language/keywords/Instructions.str>
+        #undef _
+
+        default:
+            break;
+    }
+    return ".FILL"_sv;
+}
+
+static WordValue Field(WordValue word, const OperandField& field) {
+    return static_cast<WordValue>((word & field.mask()) >> field.shift);
+}
+
+static int32_t SignExtend(WordValue value, unsigned width) {
+    int32_t signBit = int32_t{ 1 } << (width - 1);
+
+    return (static_cast<int32_t>(value) ^ signBit) - signBit;
+}
+
+static void PutAddress(TextWriter& writer, WordValue addr) {
+    writer.put('x');
+    writer.putHex(addr, 4);
+}
+
+// Writes the target of a PC-relative operand, by label if it has one.
+static void PutTarget(TextWriter& writer, WordValue addr, int32_t offset,
+                      const SymbolMap& symbols)
+{
+    auto target = static_cast<WordValue>(addr + 1 + offset);
+    auto symbol = symbols.find(target);
+
+    if (symbol != symbols.end()) {
+        writer.put(StringView{ symbol->second.data(), symbol->second.size() });
+    } else {
+        PutAddress(writer, target);
+    }
+}
+
+static void PutOperand(TextWriter& writer, WordValue addr, WordValue word,
+                       const OperandField& field, const SymbolMap& symbols)
+{
+    WordValue value = Field(word, field);
+
+    switch (field.kind) {
+        case OperandKind::Reg:
+            writer.put('R');
+            writer.put(static_cast<char>('0' + value));
+            break;
+        case OperandKind::Imm:
+        case OperandKind::Offset:
+            writer.put('#');
+            writer.putDecimal(SignExtend(value, field.width));
+            break;
+        case OperandKind::PcOffset:
+            PutTarget(writer, addr, SignExtend(value, field.width), symbols);
+            break;
+        case OperandKind::Vector:
+            writer.put('x');
+            writer.putHex(value, (field.width + 3) / 4);
+            break;
+        case OperandKind::Flags:
+        case OperandKind::None:
+            break;
+    }
+}
+
+static void PutInstruction(TextWriter& writer, WordValue addr, WordValue word,
+                           const SymbolMap& symbols)
+{
+    const InstructionForm* form = Decoder::decode(word);
+
+    if (form == nullptr) {
+        writer.put(".FILL "_sv);
+        PutAddress(writer, word);
+
+        return;
+    }
+    writer.put(Mnemonic(form->instr));
+
+    StringView separator = " "_sv;
+
+    for (const OperandField& field : form->operands) {
+        if (field.kind == OperandKind::None) break;
+
+        // Branch flags are spelled as part of the name.
+        if (field.kind == OperandKind::Flags) {
+            WordValue flags = Field(word, field);
+
+            if (flags & 0x4) writer.put('n');
+            if (flags & 0x2) writer.put('z');
+            if (flags & 0x1) writer.put('p');
+
+            continue;
+        }
+        writer.put(separator);
+        PutOperand(writer, addr, word, field, symbols);
+
+        separator = ", "_sv;
+    }
+}
+
+// Writes the line for the word at addr.
+static void DisassembleWord(TextWriter& writer, WordValue addr, WordValue word, size_t labelWidth,
+                            const SymbolMap& symbols)
+{
+    PutAddress(writer, addr);
+    writer.put(' ');
+    PutAddress(writer, word);
+    writer.put("  "_sv);
+
+    if (labelWidth > 0) {
+        auto symbol = symbols.find(addr);
+        size_t labelSize = 0;
+
+        if (symbol != symbols.end()) {
+            writer.put(StringView{ symbol->second.data(), symbol->second.size() });
+            labelSize = symbol->second.size();
+        }
+        for (; labelSize < labelWidth; ++labelSize) {
+            writer.put(' ');
+        }
+    }
+    PutInstruction(writer, addr, word, symbols);
+    writer.put('\n');
+}
+
+// Writes a line for each word, laid out like a listing: address, value,
+// then the word as an instruction, preceded by a column of labels if there
+// are any. Sections are separated by a blank line.
+void Disassemble(TextWriter& writer, const std::vector<LC3::Word>& image, const SymbolMap& symbols) {
+    size_t labelWidth = 0;
+
+    for (const auto& symbol : symbols) {
+        labelWidth = std::max(labelWidth, symbol.second.size() + 1);
+    }
+    for (size_t pos = 0; pos + LC3Format::SegmentHeaderSize <= image.size();) {
+        WordValue origin = image[pos].value();
+        size_t length = image[pos + 1].value();
+
+        if (pos > 0) {
+            writer.put('\n');
+        }
+        pos += LC3Format::SegmentHeaderSize;
+
+        for (size_t i = 0; i < length; ++i) {
+            DisassembleWord(writer, static_cast<WordValue>(origin + i), image[pos + i].value(),
+                            labelWidth, symbols);
+        }
+        pos += length;
+    }
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <lc3/Word.h>
+#include <Log.h>
+#include <LC3Writer.h>
+#include <ObjectFile.h>
+#include <Linker.h>
+#include <util/StringView.h>
+
+using Util::StringView;
+
+int Run(int argc, char** argv);
+
+int main(int argc, char** argv) {
+    int ret = Run(argc, argv);
+
+    Log::flush(std::cerr);
+
+    size_t numErrors = Log::errorCount();
+
+    if (numErrors > 0) {
+        std::cerr << "Linking failed with " << numErrors
+                  << (numErrors == 1 ? " error.\n" : " errors.\n");
+    }
+    return ret;
+}
+
+int Run(int argc, char** argv) {
+    std::vector<StringView> inputFilenames;
+    StringView outputFilename;
+
+    for (int i = 1; i < argc; ++i) {
+        StringView arg = argv[i];
+
+        if (arg == "-o") {
+            if (i + 1 == argc) {
+                Log::error(Log::Code::Usage) << "Option -o requires an argument.\n";
+
+                return 1;
+            }
+            outputFilename = argv[++i];
+        } else if (arg.beginsWith("-")) {
+            Log::error(Log::Code::Usage) << "Unknown option " << arg << ".\n";
+
+            return 1;
+        } else {
+            inputFilenames.push_back(arg);
+        }
+    }
+    if (inputFilenames.empty() || outputFilename.size() == 0) {
+        Log::error(Log::Code::Usage) << "Incorrect number of arguments.\n"
+                                     << "Usage: lc3ld input_file... -o output_file\n";
+        return 1;
+    }
+    std::vector<Linker::Module> modules;
+
+    for (StringView inputFilename : inputFilenames) {
+        auto object = ObjectFile::read(inputFilename.data());
+
+        if (!object) {
+            Log::error(Log::Code::IO) << "Unable to read object file " << inputFilename << ".\n";
+
+            return 1;
+        }
+        modules.push_back({ std::string{ inputFilename.data(), inputFilename.size() },
+                            std::move(*object) });
+    }
+    std::vector<LC3::Word> image;
+
+    if (!Linker::link(modules, image)) {
+        return 1;
+    }
+    LC3Writer writer(outputFilename.data());
+
+    if (!writer) {
+        Log::error(Log::Code::IO) << "Unable to open " << outputFilename << " for writing.\n";
+
+        return 1;
+    }
+    writer.putProgram(image);
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include "../AssemblyCache.h"
+#include "UnitTest.h"
+
+namespace fs = std::filesystem;
+
+static const uintmax_t EntrySize = 100;
+
+static fs::path TempDir() {
+    return fs::temp_directory_path() / ("lc3-cache-" + std::to_string(getpid()));
+}
+
+static fs::path WriteObject(const fs::path& dir) {
+    fs::path objectPath = dir / "input.obj";
+    std::ofstream outFile(objectPath, std::ios::binary);
+
+    outFile << std::string(EntrySize, 'x');
+
+    return objectPath;
+}
+
+int main() {
+    UnitTest(FetchesStored, t) {
+        fs::path dir = TempDir();
+        fs::create_directories(dir);
+
+        AssemblyCache cache{ dir / "cache" };
+        cache.store("a", WriteObject(dir));
+
+        t.succeedIf(cache.fetch("a", dir / "output.obj") &&
+                    fs::file_size(dir / "output.obj") == EntrySize &&
+                    !cache.fetch("b", dir / "output.obj"));
+
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    };
+
+    UnitTest(EvictsLeastRecentlyUsed, t) {
+        fs::path dir = TempDir();
+        fs::create_directories(dir);
+
+        AssemblyCache cache{ dir / "cache", 3 * EntrySize };
+        fs::path objectPath = WriteObject(dir);
+        fs::path outputPath = dir / "output.obj";
+
+        cache.store("a", objectPath);
+        cache.store("b", objectPath);
+        cache.store("c", objectPath);
+        cache.fetch("a", outputPath);
+        cache.store("d", objectPath);
+
+        // Going over the limit evicts down to three quarters of it, so that
+        // the next few stores need no scan.
+        t.succeedIf(cache.fetch("a", outputPath) && !cache.fetch("b", outputPath) &&
+                    !cache.fetch("c", outputPath) && cache.fetch("d", outputPath));
+
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    };
+
+    return RunTests();
+}
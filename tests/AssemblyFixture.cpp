@@ -0,0 +1,81 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include "../LC3Writer.h"
+#include "../language/SourceFile.h"
+#include "../language/Parser.h"
+#include "../language/TreeAnalyzer.h"
+#include "../language/SymbolTable.h"
+#include "../language/Encoder.h"
+#include "../language/Assembler.h"
+#include "AssemblyFixture.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::TreeAnalyzer;
+using LC3::Language::SymbolTable;
+using LC3::Language::Encoder;
+using LC3::Language::Assembler;
+
+std::string TempPath(const std::string& name) {
+    return "/tmp/lc3-" + std::to_string(getpid()) + "-" + name + ".obj";
+}
+
+std::string ReadFile(const std::string& path) {
+    std::ifstream inFile(path, std::ios::binary);
+
+    return std::string{ std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>() };
+}
+
+bool Assemble(const std::string& text, const std::string& outputPath) {
+    SourceFile srcFile{ text };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    LC3Writer writer(outputPath.c_str());
+    auto asTree = Parser::parse(text, symbols);
+
+    return asTree && Assembler::assemble(*asTree, symbols, writer);
+}
+
+bool AssembleWithPass(const std::string& text, const std::string& outputPath,
+                      const TreePass& pass, bool allowLiterals)
+{
+    SourceFile srcFile{ text };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    auto asTree = Parser::parse(text, symbols);
+
+    if (!asTree || !TreeAnalyzer::analyze(*asTree, false, allowLiterals) ||
+        !pass(*asTree, symbols))
+    {
+        return false;
+    }
+    auto symTable = SymbolTable::make(*asTree, symbols);
+
+    if (!symTable) {
+        return false;
+    }
+    LC3Writer writer(outputPath.c_str());
+
+    return Encoder::encode(*asTree, *symTable, writer);
+}
+
+bool SameOutput(const std::string& program, const std::string& expected,
+                const TreePass& pass, bool allowLiterals)
+{
+    std::string passPath = TempPath("pass");
+    std::string expectedPath = TempPath("expected");
+
+    bool status = AssembleWithPass(program, passPath, pass, allowLiterals) &&
+                  Assemble(expected, expectedPath) &&
+                  ReadFile(passPath) == ReadFile(expectedPath);
+
+    unlink(passPath.c_str());
+    unlink(expectedPath.c_str());
+
+    return status;
+}
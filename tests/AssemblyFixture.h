@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include "../language/SymbolInterner.h"
+#include "../language/SyntaxTreeNode.h"
+
+// Helpers for the tests of passes that rewrite a program before it is
+// encoded, which check a program against one written out by hand.
+
+// A pass over an analyzed program. Returns false if the program cannot be
+// assembled.
+using TreePass = std::function<bool(LC3::Language::SyntaxTreeNode& root,
+                                    const LC3::Language::SymbolInterner& symbols)>;
+
+// A file name under /tmp that no other test run uses.
+std::string TempPath(const std::string& name);
+
+std::string ReadFile(const std::string& path);
+
+// Assembles text to outputPath without any pass.
+bool Assemble(const std::string& text, const std::string& outputPath);
+
+// Assembles text to outputPath after running pass over it, with literals
+// allowed if allowLiterals is set.
+bool AssembleWithPass(const std::string& text, const std::string& outputPath,
+                      const TreePass& pass, bool allowLiterals = false);
+
+// Checks that program, after running pass over it, assembles to the same
+// output as expected does without.
+bool SameOutput(const std::string& program, const std::string& expected,
+                const TreePass& pass, bool allowLiterals = false);
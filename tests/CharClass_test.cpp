@@ -45,6 +45,28 @@ int main() {
     };
     UnitTestFn(Intersect, MakeTest(intersectTest));
 
+    auto betweenTest = []() {
+        constexpr CharClass isLower = CharClass::between('a', 'z');
+
+        return isLower('a') && isLower('m') && isLower('z') &&
+               !isLower('A') && !isLower('{') &&
+               isLower.numRanges() == 1 && isLower.range(0).last == 'z';
+    };
+    UnitTestFn(Between, MakeTest(betweenTest));
+
+    auto constexprTest = []() {
+        constexpr CharClass isHex = CharClass::between('0', '9') |
+                                    CharClass::between('a', 'f');
+        constexpr CharClass isNotHex = ~isHex;
+
+        static_assert(isHex('c') && !isHex('g'));
+        static_assert(isNotHex('g') && !isNotHex('7'));
+        static_assert(isHex.numRanges() == 2 && isHex.hasRanges());
+
+        return isHex('0') && !isNotHex('0');
+    };
+    UnitTestFn(Constexpr, MakeTest(constexprTest));
+
     return RunTests();
 }
 
@@ -0,0 +1,61 @@
+#include <set>
+#include "../lc3/Decoder.h"
+#include "UnitTest.h"
+
+using LC3::Decoder;
+using LC3::Language::NodeFormat;
+using LC3::Language::Keywords::Instruction;
+using LC3::Language::Keywords::InstructionForm;
+using LC3::Language::Keywords::InstructionForms;
+
+static bool Decodes(LC3::WordValue word, Instruction instr, NodeFormat format) {
+    const InstructionForm* form = Decoder::decode(word);
+
+    return form != nullptr && form->instr == instr && form->format == format;
+}
+
+static bool IsData(LC3::WordValue word) {
+    return Decoder::decode(word) == nullptr;
+}
+
+int main() {
+    UnitTest(Operates, t) {
+        t.succeedIf(Decodes(0x1261, Instruction::ADD, NodeFormat::RegRegNum) &&
+                    Decodes(0x1042, Instruction::ADD, NodeFormat::RegRegReg) &&
+                    Decodes(0x5020, Instruction::AND, NodeFormat::RegRegNum) &&
+                    Decodes(0x927F, Instruction::NOT, NodeFormat::RegReg));
+    };
+
+    UnitTest(SpecialCasesWin, t) {
+        t.succeedIf(Decodes(0xC1C0, Instruction::RET, NodeFormat::Empty) &&
+                    Decodes(0xC080, Instruction::JMP, NodeFormat::Reg) &&
+                    Decodes(0xF025, Instruction::HALT, NodeFormat::Empty) &&
+                    Decodes(0xF026, Instruction::TRAP, NodeFormat::Vec) &&
+                    Decodes(0x4801, Instruction::JSR, NodeFormat::Addr) &&
+                    Decodes(0x4080, Instruction::JSRR, NodeFormat::Reg));
+    };
+
+    UnitTest(ReservedBitsAreData, t) {
+        t.succeedIf(IsData(0x1048) && IsData(0x9200) && IsData(0xC081) && IsData(0xD000));
+    };
+
+    UnitTest(BranchNeedsFlags, t) {
+        t.succeedIf(IsData(0x0000) && IsData(0x01FF) &&
+                    Decodes(0x03FE, Instruction::BR, NodeFormat::Branch) &&
+                    Decodes(0x0E00, Instruction::BR, NodeFormat::Branch));
+    };
+
+    UnitTest(EveryFormDecodes, t) {
+        std::set<const InstructionForm*> decoded;
+
+        for (size_t word = 0; word < Decoder::TableSize; ++word) {
+            decoded.insert(Decoder::decode(static_cast<LC3::WordValue>(word)));
+        }
+        decoded.erase(nullptr);
+
+        t.succeedIf(decoded.size() == static_cast<size_t>(InstructionForms::all().end() -
+                                                          InstructionForms::all().begin()));
+    };
+
+    return RunTests();
+}
@@ -0,0 +1,122 @@
+#include <string>
+#include <vector>
+#include "../Log.h"
+#include "../language/SourceFile.h"
+#include "../language/SymbolInterner.h"
+#include "../language/Parser.h"
+#include "../language/Assembler.h"
+#include "../language/SectionMap.h"
+#include "UnitTest.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::Assembler;
+using LC3::Language::SectionMap;
+
+// Assembles the statements at x3000 and compares the words they encode to
+// expected.
+static bool Encodes(const std::string& statements, const std::vector<LC3::WordValue>& expected) {
+    std::string text = ".ORIG x3000\n" + statements + ".END\n";
+
+    SourceFile srcFile{ text };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    auto asTree = Parser::parse(text, symbols);
+
+    if (!asTree) {
+        return false;
+    }
+    Assembler assembler{ symbols };
+
+    for (auto& node : asTree->children) {
+        assembler.add(std::move(node));
+    }
+    std::vector<LC3::Word> image;
+
+    if (!assembler.finish(image) || image.size() != SectionMap::HeaderSize + expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (image[SectionMap::HeaderSize + i].value() != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(Operates, t) {
+        t.succeedIf(Encodes("ADD R1, R2, R3\n"
+                            "ADD R1, R2, #-1\n"
+                            "AND R7, R0, #15\n"
+                            "NOT R6, R7\n",
+                            { 0x1283, 0x12BF, 0x5E2F, 0x9DFF }));
+    };
+
+    UnitTest(MemoryOperands, t) {
+        t.succeedIf(Encodes("A   LD R1, A\n"
+                            "    LDR R4, R5, #-2\n"
+                            "    STR R0, R6, #31\n"
+                            "    LEA R2, B\n"
+                            "B   BRnz A\n",
+                            { 0x23FF, 0x697E, 0x719F, 0xE400, 0x0DFB }));
+    };
+
+    UnitTest(JumpsTakeBaseRegisters, t) {
+        t.succeedIf(Encodes("J   JMP R2\n"
+                            "    JSRR R3\n"
+                            "    RET\n"
+                            "    JSR J\n",
+                            { 0xC080, 0x40C0, 0xC1C0, 0x4FFC }));
+    };
+
+    UnitTest(Traps, t) {
+        t.succeedIf(Encodes("TRAP x21\n"
+                            "HALT\n",
+                            { 0xF021, 0xF025 }));
+    };
+
+    UnitTest(FieldOverflow, t) {
+        LogContext.clear();
+
+        t.succeedIf(!Encodes("ADD R1, R1, #16\n", {}) &&
+                    LogContext.text().find("Immediate cannot fit within 5 bits") != std::string::npos);
+    };
+
+    UnitTest(OffsetRange, t) {
+        // Nine bits reach from 256 words back to 255 words ahead.
+        std::vector<LC3::WordValue> edges(1 + 255 + 1, 0);
+        edges.front() = 0x0EFF;
+        edges.back() = 0x0F00;
+
+        t.succeedIf(Encodes("     BRnzp NEAR\n"
+                            "BACK .BLKW 255\n"
+                            "NEAR BRnzp BACK\n",
+                            edges));
+    };
+
+    UnitTest(OffsetOverflow, t) {
+        LogContext.clear();
+
+        t.succeedIf(!Encodes("    LD R1, FAR\n"
+                             "    .BLKW 256\n"
+                             "FAR .FILL #0\n",
+                             {}) &&
+                    LogContext.text().find("Offset cannot fit within 9 bits") != std::string::npos);
+    };
+
+    UnitTest(WrongOperands, t) {
+        LogContext.clear();
+
+        t.succeedIf(!Encodes("JMP #4\n", {}) &&
+                    LogContext.text().find("No matching format found") != std::string::npos);
+    };
+
+    return RunTests();
+}
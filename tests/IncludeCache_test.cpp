@@ -0,0 +1,175 @@
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../Log.h"
+#include "../language/SourceFile.h"
+#include "../language/SymbolInterner.h"
+#include "../language/Parser.h"
+#include "../language/Assembler.h"
+#include "../language/IncludeCache.h"
+#include "UnitTest.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::Assembler;
+using LC3::Language::IncludeCache;
+
+static const std::string Library =
+    "PRINT   LEA R0, MSG\n"
+    "        PUTS\n"
+    "        RET\n"
+    "MSG     .STRINGZ \"hi\"\n";
+
+static const std::string Program =
+    ".ORIG x3000\n"
+    "        JSR PRINT\n"
+    "        HALT\n"
+    "        .INCLUDE \"lib.asm\"\n"
+    "        .END\n";
+
+static std::string TempDir() {
+    return "/tmp/lc3-" + std::to_string(getpid()) + "-include";
+}
+
+static std::string WriteFile(const std::string& name, const std::string& text) {
+    std::string path = TempDir() + "/" + name;
+    std::ofstream outFile(path);
+
+    outFile << text;
+
+    return path;
+}
+
+static std::string Replace(std::string text, const std::string& from, const std::string& to) {
+    return text.replace(text.find(from), from.size(), to);
+}
+
+static bool Assemble(const std::string& text, const std::string& directory,
+                     std::vector<LC3::Word>& image)
+{
+    SourceFile srcFile{ text, directory };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    auto asTree = Parser::parse(srcFile.text(), symbols);
+
+    return asTree && Assembler::assemble(*asTree, symbols, image);
+}
+
+static bool SameImage(const std::vector<LC3::Word>& lhs, const std::vector<LC3::Word>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i].value() != rhs[i].value()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    std::string mkdirCmd = "mkdir -p " + TempDir();
+
+    if (std::system(mkdirCmd.c_str()) != 0) {
+        return 1;
+    }
+    WriteFile("lib.asm", Library);
+
+    UnitTest(LexedOnce, t) {
+        auto first = IncludeCache::load("lib.asm", TempDir());
+        auto second = IncludeCache::load(TempDir() + "/./lib.asm", "");
+
+        t.succeedIf(first != nullptr && first == second && !first->tokens.empty());
+    };
+
+    UnitTest(MissingFile, t) {
+        t.succeedIf(IncludeCache::load("missing.asm", TempDir()) == nullptr);
+    };
+
+    UnitTest(ChangedFileIsReleased, t) {
+        WriteFile("changing.asm", Library);
+
+        auto first = IncludeCache::load("changing.asm", TempDir());
+        std::weak_ptr<const IncludeCache::File> firstRef = first;
+
+        WriteFile("changing.asm", Library + "        HALT\n");
+
+        auto second = IncludeCache::load("changing.asm", TempDir());
+        bool reloaded = second != nullptr && second != first;
+
+        first.reset();
+
+        t.succeedIf(reloaded && firstRef.expired());
+    };
+
+    UnitTest(SourceFileHoldsIncludes, t) {
+        WriteFile("outer.asm", ".INCLUDE \"lib.asm\"\n");
+
+        std::string text = Replace(Program, "lib.asm", "outer.asm");
+        SourceFile srcFile{ text, TempDir() };
+        SourceFile::Scope srcScope{ srcFile };
+
+        SymbolInterner symbols;
+        auto asTree = Parser::parse(srcFile.text(), symbols);
+        auto includes = srcFile.includes();
+
+        t.succeedIf(asTree && includes.size() == 2 &&
+                    includes[0].find("outer.asm") != std::string::npos &&
+                    includes[1].find("lib.asm") != std::string::npos);
+    };
+
+    UnitTest(SameAsPasted, t) {
+        std::vector<LC3::Word> included;
+        std::vector<LC3::Word> pasted;
+
+        t.succeedIf(Assemble(Program, TempDir(), included) &&
+                    Assemble(Replace(Program, "        .INCLUDE \"lib.asm\"\n", Library), "",
+                             pasted) &&
+                    SameImage(included, pasted));
+    };
+
+    UnitTest(Nested, t) {
+        WriteFile("outer.asm", ".INCLUDE \"lib.asm\"\n");
+
+        std::vector<LC3::Word> nested;
+        std::vector<LC3::Word> direct;
+
+        t.succeedIf(Assemble(Replace(Program, "lib.asm", "outer.asm"), TempDir(), nested) &&
+                    Assemble(Program, TempDir(), direct) &&
+                    SameImage(nested, direct));
+    };
+
+    UnitTest(IncludesItself, t) {
+        WriteFile("self.asm", ".INCLUDE \"self.asm\"\n");
+
+        std::vector<LC3::Word> image;
+
+        t.succeedIf(!Assemble(Replace(Program, "lib.asm", "self.asm"), TempDir(), image));
+    };
+
+    UnitTest(DiagnosticNamesFile, t) {
+        WriteFile("bad.asm", "        .FILL\n");
+
+        std::vector<LC3::Word> image;
+        LogContext.clear();
+
+        bool status = Assemble(Replace(Program, "lib.asm", "bad.asm"), TempDir(), image);
+
+        t.succeedIf(!status && LogContext.text().find("bad.asm:1:") != std::string::npos);
+    };
+
+    int ret = RunTests();
+
+    std::string rmCmd = "rm -rf " + TempDir();
+    std::system(rmCmd.c_str());
+
+    return ret;
+}
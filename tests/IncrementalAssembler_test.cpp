@@ -0,0 +1,223 @@
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../Log.h"
+#include "../language/SourceFile.h"
+#include "../language/SymbolInterner.h"
+#include "../language/Parser.h"
+#include "../language/Assembler.h"
+#include "../language/IncrementalAssembler.h"
+#include "UnitTest.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::Assembler;
+using LC3::Language::IncrementalAssembler;
+
+static const std::string BaseProgram =
+    ".ORIG x3000\n"
+    "        LD R1, COUNT\n"
+    "LOOP    ADD R0, R0, #1\n"
+    "        ADD R1, R1, #-1\n"
+    "        BRp LOOP\n"
+    "        LEA R2, MSG\n"
+    "        HALT\n"
+    "COUNT   .FILL #5\n"
+    "MSG     .STRINGZ \"hi\"\n"
+    "        .END\n";
+
+static const std::string TwoSections =
+    ".ORIG x3000\n"
+    "        LD R1, VALUE\n"
+    "        HALT\n"
+    "        .END\n"
+    ".ORIG x3004\n"
+    "VALUE   .FILL #9\n"
+    "        .END\n";
+
+static std::string Replace(std::string text, const std::string& from, const std::string& to) {
+    return text.replace(text.find(from), from.size(), to);
+}
+
+static bool SameAsFull(const IncrementalAssembler& assembler, const std::string& text) {
+    SourceFile srcFile{ text };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    std::vector<LC3::Word> image;
+    auto asTree = Parser::parse(text, symbols);
+
+    if (!asTree || !Assembler::assemble(*asTree, symbols, image)) {
+        return false;
+    }
+    if (image.size() != assembler.image().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < image.size(); ++i) {
+        if (image[i].value() != assembler.image()[i].value()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(FirstUpdateIsFull, t) {
+        IncrementalAssembler assembler;
+
+        t.succeedIf(assembler.update(BaseProgram) &&
+                    !assembler.wasIncremental() &&
+                    SameAsFull(assembler, BaseProgram));
+    };
+
+    UnitTest(SameSizeEdit, t) {
+        IncrementalAssembler assembler;
+        std::string edited = Replace(BaseProgram, "#5", "#7");
+
+        t.succeedIf(assembler.update(BaseProgram) &&
+                    assembler.update(edited) &&
+                    assembler.wasIncremental() &&
+                    SameAsFull(assembler, edited));
+    };
+
+    UnitTest(InsertedLineMovesLabels, t) {
+        IncrementalAssembler assembler;
+        std::string edited = Replace(BaseProgram, "        HALT\n",
+                                     "        ADD R3, R3, #0\n        HALT\n");
+
+        t.succeedIf(assembler.update(BaseProgram) &&
+                    assembler.update(edited) &&
+                    assembler.wasIncremental() &&
+                    SameAsFull(assembler, edited));
+    };
+
+    UnitTest(DeletedLine, t) {
+        IncrementalAssembler assembler;
+        std::string edited = Replace(BaseProgram, "        ADD R1, R1, #-1\n", "");
+
+        t.succeedIf(assembler.update(BaseProgram) &&
+                    assembler.update(edited) &&
+                    assembler.wasIncremental() &&
+                    SameAsFull(assembler, edited));
+    };
+
+    UnitTest(ResizedString, t) {
+        IncrementalAssembler assembler;
+        std::string edited = Replace(BaseProgram, "\"hi\"", "\"hello\"");
+
+        t.succeedIf(assembler.update(BaseProgram) &&
+                    assembler.update(edited) &&
+                    assembler.wasIncremental() &&
+                    SameAsFull(assembler, edited));
+    };
+
+    UnitTest(LabelOnItsOwnLine, t) {
+        IncrementalAssembler assembler;
+        std::string first = Replace(BaseProgram, "COUNT   .FILL #5\n",
+                                    "COUNT\n        .FILL #5\n");
+        std::string second = Replace(first, "        .FILL #5\n",
+                                     "        .BLKW 2\n        .FILL #5\n");
+
+        t.succeedIf(assembler.update(first) &&
+                    assembler.update(second) &&
+                    assembler.wasIncremental() &&
+                    SameAsFull(assembler, second));
+    };
+
+    UnitTest(EditSequence, t) {
+        IncrementalAssembler assembler;
+        std::string text = BaseProgram;
+        bool status = assembler.update(text);
+
+        const std::vector<std::pair<std::string, std::string>> edits = {
+            { "HALT\n", "HALT\nEXTRA   .BLKW 3\n" },
+            { "LEA R2, MSG", "LEA R2, EXTRA" },
+            { "LEA R2, EXTRA", "LEA R2, COUNT" },
+            { "EXTRA   .BLKW 3\n", "" },
+            { "BRp LOOP", "BRnp LOOP" },
+        };
+        for (const auto& edit : edits) {
+            text = Replace(text, edit.first, edit.second);
+            status = status && assembler.update(text) && SameAsFull(assembler, text);
+        }
+        t.succeedIf(status);
+    };
+
+    UnitTest(OrigEditIsFull, t) {
+        IncrementalAssembler assembler;
+        std::string edited = Replace(BaseProgram, "x3000", "x4000");
+
+        t.succeedIf(assembler.update(BaseProgram) &&
+                    assembler.update(edited) &&
+                    !assembler.wasIncremental() &&
+                    SameAsFull(assembler, edited));
+    };
+
+    UnitTest(SecondSection, t) {
+        IncrementalAssembler assembler;
+        std::string edited = Replace(TwoSections, "HALT\n", "ADD R1, R1, #1\n        HALT\n");
+
+        bool status = assembler.update(TwoSections) && SameAsFull(assembler, TwoSections) &&
+                      assembler.image().size() == 7 &&
+                      assembler.image()[1].value() == 2 &&
+                      assembler.image()[4].value() == 0x3004 &&
+                      assembler.image()[5].value() == 1;
+
+        t.succeedIf(status &&
+                    assembler.update(edited) &&
+                    assembler.wasIncremental() &&
+                    SameAsFull(assembler, edited));
+    };
+
+    UnitTest(GrowIntoNextSection, t) {
+        IncrementalAssembler assembler;
+        std::string edited = Replace(TwoSections, "HALT\n", ".BLKW 3\n        HALT\n");
+        size_t errorsBefore = LogContext.errorCount();
+
+        t.succeedIf(assembler.update(TwoSections) &&
+                    !assembler.update(edited) &&
+                    LogContext.errorCount() == errorsBefore + 1);
+    };
+
+    UnitTest(ListsIncludes, t) {
+        std::string libPath = "/tmp/lc3-" + std::to_string(getpid()) + "-incremental.asm";
+        {
+            std::ofstream libFile(libPath);
+            libFile << "LIB     .FILL #1\n";
+        }
+        IncrementalAssembler assembler;
+        bool included = assembler.update(Replace(BaseProgram, "        .END\n",
+                                                 "        .INCLUDE \"" + libPath + "\"\n"
+                                                 "        .END\n")) &&
+                        assembler.includes().size() == 1 &&
+                        assembler.includes()[0] == libPath;
+        bool dropped = assembler.update(BaseProgram) && assembler.includes().empty();
+
+        unlink(libPath.c_str());
+
+        t.succeedIf(included && dropped);
+    };
+
+    UnitTest(ErrorThenFix, t) {
+        IncrementalAssembler assembler;
+        std::string broken = Replace(BaseProgram, "LEA R2, MSG", "LEA R2, NOWHERE");
+
+        bool status = assembler.update(BaseProgram);
+        size_t errorsBefore = LogContext.errorCount();
+
+        status = status && !assembler.update(broken) &&
+                 LogContext.errorCount() > errorsBefore;
+
+        t.succeedIf(status &&
+                    assembler.update(BaseProgram) &&
+                    SameAsFull(assembler, BaseProgram));
+    };
+
+    return RunTests();
+}
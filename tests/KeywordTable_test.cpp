@@ -0,0 +1,66 @@
+#include <util/KeywordTable.h>
+#include <util/StringView.h>
+#include "UnitTest.h"
+
+using Util::StringView;
+using Util::KeywordTable;
+
+enum class Color {
+    None,
+    Red,
+    Green,
+    Blue,
+    Magenta
+};
+
+using ColorTable = KeywordTable<Color, 4>;
+
+static constexpr ColorTable::Entry ColorEntries[] = {
+    { "RED"_sv, Color::Red },
+    { "GREEN"_sv, Color::Green },
+    { "BLUE"_sv, Color::Blue },
+    { "MAGENTA"_sv, Color::Magenta }
+};
+
+static constexpr ColorTable Colors{ ColorEntries };
+
+static bool Finds(StringView word, Color expected) {
+    const Color* found = Colors.find(word);
+
+    return found != nullptr && *found == expected;
+}
+
+int main() {
+    UnitTest(Exact, t) {
+        t.succeedIf(Finds("RED", Color::Red) && Finds("MAGENTA", Color::Magenta));
+    };
+
+    UnitTest(Caseless, t) {
+        t.succeedIf(Finds("green", Color::Green) && Finds("bLuE", Color::Blue));
+    };
+
+    UnitTest(Missing, t) {
+        t.succeedIf(Colors.find("YELLOW") == nullptr &&
+                    Colors.find("RE") == nullptr &&
+                    Colors.find("REDD") == nullptr);
+    };
+
+    UnitTest(TooLong, t) {
+        t.succeedIf(Colors.find("MAGENTAMAGENTA") == nullptr);
+    };
+
+    UnitTest(Empty, t) {
+        t.succeedIf(Colors.find("") == nullptr);
+    };
+
+    UnitTest(NonLetters, t) {
+        // '@' and '[' border the uppercase letters, '`' and '{' the lowercase
+        // ones. None of them may be folded onto a letter.
+        t.succeedIf(Colors.find("@ED") == nullptr &&
+                    Colors.find("R{D") == nullptr &&
+                    Colors.find("`ED") == nullptr &&
+                    Colors.find("RE\xC4") == nullptr);
+    };
+
+    return RunTests();
+}
@@ -1,13 +1,116 @@
-#include <iostream>
+#include <vector>
 #include <lc3/Word.h>
+#include <LC3Format.h>
+#include <LC3Reader.h>
 #include <LC3Writer.h>
+#include "UnitTest.h"
+
+static const char* const FileName = "LC3Writer_test.obj";
+
+static bool SameWords(const std::vector<LC3::Word>& one, const std::vector<LC3::Word>& two) {
+    if (one.size() != two.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < one.size(); ++i) {
+        if (one[i].value() != two[i].value()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool WriteWords(const std::vector<LC3::Word>& words) {
+    LC3Writer writer(FileName);
+    bool status = static_cast<bool>(writer);
+
+    for (LC3::Word word : words) {
+        status = status && writer.putWord(word);
+    }
+    return status;
+}
+
+static std::vector<LC3::Word> ReadWords() {
+    LC3Reader reader(FileName);
+    std::vector<LC3::Word> words;
+    LC3::Word word;
+
+    while (reader.getWord(word)) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+static bool WriteProgram(const std::vector<LC3::Word>& image) {
+    LC3Writer writer(FileName);
+
+    return writer && writer.putProgram(image);
+}
+
+static bool ReadProgram(std::vector<LC3::Word>& image) {
+    LC3Reader reader(FileName);
+
+    return reader.getProgram(image);
+}
 
 int main() {
-    LC3Writer writer("LC3Writer_test.obj");
+    UnitTest(OneSectionIsClassic, t) {
+        std::vector<LC3::Word> image = { 0x3000, 2, 1, 2 };
+        std::vector<LC3::Word> expected = { 0x3000, 1, 2 };
+
+        t.succeedIf(WriteProgram(image) && SameWords(ReadWords(), expected));
+    };
+
+    UnitTest(SeveralSectionsHaveHeader, t) {
+        std::vector<LC3::Word> image = { 0x3000, 1, 1, 0x4000, 2, 2, 3 };
+        std::vector<LC3::Word> expected = {
+            LC3Format::Magic[0], LC3Format::Magic[1], LC3Format::Version, 2,
+            0x3000, 1, 1, 0x4000, 2, 2, 3
+        };
+
+        t.succeedIf(WriteProgram(image) && SameWords(ReadWords(), expected));
+    };
+
+    UnitTest(RejectsMismatchedLength, t) {
+        std::vector<LC3::Word> image = { 0x3000, 1, 1, 2 };
+
+        t.succeedIf(!WriteProgram(image));
+    };
+
+    UnitTest(ReadsClassic, t) {
+        std::vector<LC3::Word> image;
+
+        t.succeedIf(WriteWords({ 0x3000, 1, 2 }) && ReadProgram(image) &&
+                    SameWords(image, { 0x3000, 2, 1, 2 }));
+    };
+
+    UnitTest(ReadsSections, t) {
+        std::vector<LC3::Word> image = { 0x3000, 1, 1, 0x4000, 0, 0x5000, 2, 2, 3 };
+        std::vector<LC3::Word> readImage;
+
+        t.succeedIf(WriteProgram(image) && ReadProgram(readImage) &&
+                    SameWords(readImage, image));
+    };
+
+    UnitTest(RejectsTruncatedSection, t) {
+        std::vector<LC3::Word> image;
+
+        t.failIf(!WriteWords({ LC3Format::Magic[0], LC3Format::Magic[1], LC3Format::Version, 1,
+                               0x3000, 2, 1 }) ||
+                 ReadProgram(image));
+    };
+
+    UnitTest(RejectsSectionPastMemory, t) {
+        std::vector<LC3::Word> image;
+
+        t.failIf(!WriteWords({ 0xFFFE, 1, 2, 3 }) || ReadProgram(image));
+    };
+
+    UnitTest(RejectsUnknownVersion, t) {
+        std::vector<LC3::Word> image;
 
-    writer.putWord(0x3000);
-    writer.putWord(0);
-    writer.putWord(1);
+        t.failIf(!WriteWords({ LC3Format::Magic[0], LC3Format::Magic[1], 2, 0 }) ||
+                 ReadProgram(image));
+    };
 
-    return 0;
+    return RunTests();
 }
@@ -0,0 +1,192 @@
+#include <string>
+#include <vector>
+#include "../Log.h"
+#include "../Linker.h"
+#include "../language/SourceFile.h"
+#include "../language/SymbolInterner.h"
+#include "../language/Parser.h"
+#include "../language/Assembler.h"
+#include "../language/ObjectAssembler.h"
+#include "UnitTest.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::Assembler;
+using LC3::Language::ObjectAssembler;
+
+static const std::string MainModule =
+    "        .EXTERNAL PRINT\n"
+    "        .EXTERNAL COUNT\n"
+    "        .GLOBAL MSG\n"
+    "        .ORIG x3000\n"
+    "        LD R1, COUNT\n"
+    "LOOP    LEA R0, MSG\n"
+    "        JSR PRINT\n"
+    "        ADD R1, R1, #-1\n"
+    "        BRp LOOP\n"
+    "        HALT\n"
+    "PTR     .FILL COUNT\n"
+    "MSG     .STRINGZ \"hi\"\n"
+    "        .END\n";
+
+static const std::string LibModule =
+    "        .EXTERNAL MSG\n"
+    "        .GLOBAL PRINT\n"
+    "        .GLOBAL COUNT\n"
+    "        .ORIG x5000\n"
+    "PRINT   PUTS\n"
+    "        LEA R3, MSG\n"
+    "        RET\n"
+    "SELF    .FILL SELF\n"
+    "COUNT   .FILL #3\n"
+    "TABLE   .BLKW 2 PRINT\n"
+    "        .END\n";
+
+// The two modules above as a single program.
+static const std::string WholeProgram =
+    "        .ORIG x3000\n"
+    "        LD R1, COUNT\n"
+    "LOOP    LEA R0, MSG\n"
+    "        JSR PRINT\n"
+    "        ADD R1, R1, #-1\n"
+    "        BRp LOOP\n"
+    "        HALT\n"
+    "PTR     .FILL COUNT\n"
+    "MSG     .STRINGZ \"hi\"\n"
+    "PRINT   PUTS\n"
+    "        LEA R3, MSG\n"
+    "        RET\n"
+    "SELF    .FILL SELF\n"
+    "COUNT   .FILL #3\n"
+    "TABLE   .BLKW 2 PRINT\n"
+    "        .END\n";
+
+static Log::Context LogContext;
+
+static Linker::Module MakeModule(const std::string& name, const std::string& src) {
+    SourceFile srcFile{ src };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    Linker::Module module{ name, {} };
+    auto asTree = Parser::parse(src, symbols);
+
+    if (!asTree || !ObjectAssembler::assemble(*asTree, symbols, module.object)) {
+        module.object.sections.clear();
+    }
+    return module;
+}
+
+static std::vector<LC3::Word> AssembleWhole(const std::string& src) {
+    SourceFile srcFile{ src };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    std::vector<LC3::Word> image;
+    auto asTree = Parser::parse(src, symbols);
+
+    if (asTree) {
+        Assembler::assemble(*asTree, symbols, image);
+    }
+    return image;
+}
+
+static bool SameImage(const std::vector<LC3::Word>& one, const std::vector<LC3::Word>& two) {
+    if (one.size() != two.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < one.size(); ++i) {
+        if (one[i].value() != two[i].value()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(MatchesWholeProgram, t) {
+        std::vector<Linker::Module> modules = {
+            MakeModule("main", MainModule),
+            MakeModule("lib", LibModule)
+        };
+        std::vector<LC3::Word> image;
+
+        t.succeedIf(Linker::link(modules, image) &&
+                    SameImage(image, AssembleWhole(WholeProgram)));
+    };
+
+    UnitTest(LocalReferencesNeedNoRelocation, t) {
+        Linker::Module module = MakeModule("lib", LibModule);
+        size_t numRelocs = module.object.sections.at(0).relocations.size();
+
+        // LEA R3, MSG, .FILL SELF and both words of .BLKW 2 PRINT.
+        t.succeedIf(numRelocs == 4);
+    };
+
+    UnitTest(CrossSectionReference, t) {
+        std::string src =
+            "        .ORIG x3000\n"
+            "MAIN    BRnzp FAR\n"
+            "        .END\n"
+            "        .ORIG x3100\n"
+            "FAR     .FILL #7\n"
+            "        .END\n";
+        std::vector<Linker::Module> modules = { MakeModule("main", src) };
+        std::vector<LC3::Word> image;
+
+        // The second section goes right after the first, so the branch
+        // lands on the next word.
+        t.succeedIf(Linker::link(modules, image) && image.size() == 4 &&
+                    image[2].value() == 0x0E00 && image[3].value() == 7);
+    };
+
+    UnitTest(UndefinedImport, t) {
+        std::vector<Linker::Module> modules = { MakeModule("main", MainModule) };
+        std::vector<LC3::Word> image;
+        size_t errorsBefore = LogContext.errorCount();
+
+        t.succeedIf(!Linker::link(modules, image) &&
+                    LogContext.errorCount() == errorsBefore + 2);
+    };
+
+    UnitTest(DuplicateExport, t) {
+        std::vector<Linker::Module> modules = {
+            MakeModule("main", MainModule),
+            MakeModule("lib", LibModule),
+            MakeModule("lib2", LibModule)
+        };
+        std::vector<LC3::Word> image;
+
+        t.succeedIf(!Linker::link(modules, image));
+    };
+
+    UnitTest(OffsetOutOfRange, t) {
+        std::string farModule =
+            "        .GLOBAL FAR\n"
+            "        .ORIG x4000\n"
+            "        .BLKW 300\n"
+            "FAR     .FILL #0\n"
+            "        .END\n";
+        std::string nearModule =
+            "        .EXTERNAL FAR\n"
+            "        .ORIG x3000\n"
+            "        LD R0, FAR\n"
+            "        .END\n";
+        std::vector<Linker::Module> modules = {
+            MakeModule("near", nearModule),
+            MakeModule("far", farModule)
+        };
+        std::vector<LC3::Word> image;
+
+        t.succeedIf(!Linker::link(modules, image));
+    };
+
+    UnitTest(ExternalOutsideObject, t) {
+        t.succeedIf(AssembleWhole(MainModule).empty());
+    };
+
+    return RunTests();
+}
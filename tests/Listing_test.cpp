@@ -0,0 +1,146 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../Log.h"
+#include "../language/SourceFile.h"
+#include "../language/SymbolInterner.h"
+#include "../language/Parser.h"
+#include "../language/Assembler.h"
+#include "../language/Listing.h"
+#include "../util/TextWriter.h"
+#include "UnitTest.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::Assembler;
+using LC3::Language::Listing;
+
+static const std::string Program =
+    "; Counts down.\n"
+    ".ORIG x3000\n"
+    "        LD R1, COUNT\n"
+    "LOOP    ADD R1, R1, #-1\n"
+    "        BRp LOOP\n"
+    "        HALT\n"
+    "COUNT   .FILL #5\n"
+    "MSG     .STRINGZ \"hi\"\n"
+    "        .END\n";
+
+static std::string TempPath(const std::string& name) {
+    return "/tmp/lc3-" + std::to_string(getpid()) + "-" + name;
+}
+
+static std::string ReadFile(const std::string& path) {
+    std::ifstream inFile(path, std::ios::binary);
+
+    return std::string{ std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>() };
+}
+
+// Assembles text and writes both maps of it, returning their contents.
+static bool WriteMaps(const std::string& text, std::string& listing, std::string& symbolMap) {
+    SourceFile srcFile{ text };
+    SourceFile::Scope srcScope{ srcFile };
+
+    SymbolInterner symbols;
+    auto asTree = Parser::parse(text, symbols);
+
+    if (!asTree) {
+        return false;
+    }
+    Assembler assembler{ symbols };
+    assembler.recordPlacements();
+
+    for (auto& node : asTree->children) {
+        assembler.add(std::move(node));
+    }
+    std::vector<LC3::Word> image;
+
+    if (!assembler.finish(image)) {
+        return false;
+    }
+    std::string listingPath = TempPath("listing.lst");
+    std::string symbolPath = TempPath("symbols.sym");
+
+    bool status = Listing::writeListing(listingPath.c_str(), image, assembler.placements()) &&
+                  Listing::writeSymbols(symbolPath.c_str(), assembler.symbolTable());
+
+    listing = ReadFile(listingPath);
+    symbolMap = ReadFile(symbolPath);
+
+    unlink(listingPath.c_str());
+    unlink(symbolPath.c_str());
+
+    return status;
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(ListsEveryWord, t) {
+        std::string listing;
+        std::string symbolMap;
+
+        t.succeedIf(WriteMaps(Program, listing, symbolMap) &&
+                    listing == "x3000        .ORIG x3000\n"
+                               "x3000 x2203          LD R1, COUNT\n"
+                               "x3001 x127f  LOOP    ADD R1, R1, #-1\n"
+                               "x3002 x03fe          BRp LOOP\n"
+                               "x3003 xf025          HALT\n"
+                               "x3004 x0005  COUNT   .FILL #5\n"
+                               "x3005 x0068  MSG     .STRINGZ \"hi\"\n"
+                               "x3006 x0069\n"
+                               "x3007 x0000\n");
+    };
+
+    UnitTest(SymbolsByAddress, t) {
+        std::string listing;
+        std::string symbolMap;
+
+        t.succeedIf(WriteMaps(Program, listing, symbolMap) &&
+                    symbolMap == "x3001 LOOP\n"
+                                 "x3004 COUNT\n"
+                                 "x3005 MSG\n");
+    };
+
+    UnitTest(SecondSection, t) {
+        std::string listing;
+        std::string symbolMap;
+
+        t.succeedIf(WriteMaps(".ORIG x3000\nA .FILL x1234\n.END\n"
+                              ".ORIG x4000\nB .FILL A\n.END\n", listing, symbolMap) &&
+                    listing == "x3000        .ORIG x3000\n"
+                               "x3000 x1234  A .FILL x1234\n"
+                               "x4000        .ORIG x4000\n"
+                               "x4000 x3000  B .FILL A\n" &&
+                    symbolMap == "x3000 A\nx4000 B\n");
+    };
+
+    UnitTest(WriterPadsAndSpansBuffers, t) {
+        std::string path = TempPath("text.txt");
+        std::string longText(Util::TextWriter::BufferSize + 10, 'a');
+        bool status = false;
+        {
+            Util::TextWriter writer{ path.c_str() };
+
+            writer.putHex(0xa, 4);
+            writer.put(' ');
+            writer.putHex(0x12345, 4);
+            writer.put(Util::StringView{ longText.data(), longText.size() });
+            writer.putHex(0, 1);
+
+            status = writer.close();
+        }
+        std::string text = ReadFile(path);
+
+        unlink(path.c_str());
+
+        t.succeedIf(status && text == "000a 12345" + longText + "0");
+    };
+
+    return RunTests();
+}
@@ -0,0 +1,122 @@
+#include <string>
+#include <unistd.h>
+#include "../Log.h"
+#include "../language/Parser.h"
+#include "../language/TreeAnalyzer.h"
+#include "../language/LiteralPools.h"
+#include "AssemblyFixture.h"
+#include "UnitTest.h"
+
+using LC3::Language::SyntaxTreeNode;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::TreeAnalyzer;
+using LC3::Language::LiteralPools;
+
+static bool Place(SyntaxTreeNode& root, const SymbolInterner&) {
+    return LiteralPools::place(root);
+}
+
+// Checks that the program assembles with its literal pools to the same
+// output as expected does without any.
+static bool Pools(const std::string& program, const std::string& expected) {
+    return SameOutput(program, expected, Place, true);
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(PlacesAfterUnconditionalTransfers, t) {
+        t.succeedIf(Pools(".ORIG x3000\n"
+                          "    LD R0, =#1234\n"
+                          "    LD R1, =x00FF\n"
+                          "    LD R2, =1234\n"
+                          "    HALT\n"
+                          "    ADD R0, R0, R1\n"
+                          "    RET\n"
+                          ".END\n",
+                          ".ORIG x3000\n"
+                          "    LD R0, x3004\n"
+                          "    LD R1, x3005\n"
+                          "    LD R2, x3004\n"
+                          "    HALT\n"
+                          "    .FILL #1234\n"
+                          "    .FILL x00FF\n"
+                          "    ADD R0, R0, R1\n"
+                          "    RET\n"
+                          ".END\n"));
+    };
+
+    UnitTest(ReusesEarlierPools, t) {
+        t.succeedIf(Pools(".ORIG x3000\n"
+                          "     LD R0, =TABLE\n"
+                          "     BRnzp NEXT\n"
+                          "NEXT LD R1, =TABLE\n"
+                          "     LD R2, =#-1\n"
+                          "     RET\n"
+                          "TABLE .FILL #7\n"
+                          ".END\n",
+                          ".ORIG x3000\n"
+                          "     LD R0, x3002\n"
+                          "     BRnzp NEXT\n"
+                          "     .FILL TABLE\n"
+                          "NEXT LD R1, x3002\n"
+                          "     LD R2, x3006\n"
+                          "     RET\n"
+                          "     .FILL #-1\n"
+                          "TABLE .FILL #7\n"
+                          ".END\n"));
+    };
+
+    UnitTest(NumericAddressesFollowStatements, t) {
+        t.succeedIf(Pools(".ORIG x3000\n"
+                          "    LD R0, =#5\n"
+                          "    BRz x3003\n"
+                          "    RET\n"
+                          "    HALT\n"
+                          ".END\n",
+                          ".ORIG x3000\n"
+                          "    LD R0, x3003\n"
+                          "    BRz x3004\n"
+                          "    RET\n"
+                          "    .FILL #5\n"
+                          "    HALT\n"
+                          ".END\n"));
+    };
+
+    UnitTest(RejectsFarPools, t) {
+        t.succeedIf(!AssembleWithPass(".ORIG x3000\n"
+                                      "    LD R0, =#1\n"
+                                      "    .BLKW 300\n"
+                                      "    HALT\n"
+                                      ".END\n",
+                                      TempPath("far"), Place, true));
+        unlink(TempPath("far").c_str());
+    };
+
+    UnitTest(RejectsOtherInstructions, t) {
+        SymbolInterner symbols;
+        auto asTree = Parser::parse(".ORIG x3000\n"
+                                    "    ADD R0, R0, =#1\n"
+                                    ".END\n",
+                                    symbols);
+
+        t.succeedIf(asTree.has_value() && !TreeAnalyzer::analyze(*asTree, false, true));
+    };
+
+    UnitTest(NeedsPlacement, t) {
+        SymbolInterner symbols;
+        auto asTree = Parser::parse(".ORIG x3000\n"
+                                    "    LD R0, =#1\n"
+                                    "    HALT\n"
+                                    ".END\n",
+                                    symbols);
+
+        t.succeedIf(asTree.has_value() && LiteralPools::used(*asTree) &&
+                    !TreeAnalyzer::analyze(*asTree));
+    };
+
+    return RunTests();
+}
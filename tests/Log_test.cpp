@@ -0,0 +1,128 @@
+#include <sstream>
+#include <string>
+#include "../Log.h"
+#include "../language/SourceFile.h"
+#include "../language/SourceLocation.h"
+#include "UnitTest.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SourceLocation;
+
+namespace {
+
+struct At {
+    uint32_t offset;
+
+    void locate(Log::Diagnostic& diag) const {
+        LC3::Language::Locate(diag, SourceLocation{ offset });
+    }
+};
+
+} // namespace
+
+static std::string Render(const Log::Context& context, Log::Format format,
+                          const std::string& mainFile = {})
+{
+    std::ostringstream outStream;
+    context.render(outStream, format, mainFile);
+
+    return outStream.str();
+}
+
+int main() {
+    static const std::string src = "  ADD R1\n\tBR A\n";
+
+    UnitTest(TextMatchesSourceContext, t) {
+        SourceFile srcFile{ src };
+        SourceFile::Scope srcScope{ srcFile };
+
+        Log::Context context;
+        {
+            Log::Scope logScope{ context };
+
+            Log::error(At{ 2 }) << "Unknown instruction.\n";
+            Log::warning(At{ 10 }) << "No flags.\n";
+            Log::error() << "Unable to write out.obj.\n";
+        }
+        t.succeedIf(context.errorCount() == 2 && context.warningCount() == 1 &&
+                    context.text() == "Error: [1:2]\n  ADD R1\n  ^\nUnknown instruction.\n"
+                                      "Warning: [2:1]\n\tBR A\n ^\nNo flags.\n"
+                                      "Error: Unable to write out.obj.\n");
+    };
+
+    UnitTest(JsonLines, t) {
+        SourceFile srcFile{ src };
+        SourceFile::Scope srcScope{ srcFile };
+
+        Log::Context context;
+        {
+            Log::Scope logScope{ context };
+
+            Log::error(At{ 2 }, Log::Code::Syntax) << "Say \"hi\"\\\n";
+            Log::warning() << "Two\nlines.\n";
+            Log::error(Log::Code::IO) << "Unable to write out.obj.\n";
+        }
+        t.succeedIf(Render(context, Log::Format::JsonLines, "prog.asm") ==
+                    "{\"severity\":\"error\",\"code\":\"syntax\",\"file\":\"prog.asm\","
+                    "\"offset\":2,\"line\":1,\"column\":2,"
+                    "\"message\":\"Say \\\"hi\\\"\\\\\"}\n"
+                    "{\"severity\":\"warning\",\"code\":\"general\",\"file\":\"prog.asm\","
+                    "\"message\":\"Two\\nlines.\"}\n"
+                    "{\"severity\":\"error\",\"code\":\"io\",\"file\":\"prog.asm\","
+                    "\"message\":\"Unable to write out.obj.\"}\n");
+    };
+
+    UnitTest(UnresolvedOffset, t) {
+        Log::Context context;
+        {
+            Log::Scope logScope{ context };
+
+            Log::error(At{ 7 }) << "Bad.\n";
+        }
+        t.succeedIf(context.text() == "Error: [@7]\nBad.\n");
+    };
+
+    UnitTest(MaxErrors, t) {
+        Log::setMaxErrors(2);
+
+        Log::Context context;
+        {
+            Log::Scope logScope{ context };
+
+            for (int i = 0; i < 5; ++i) {
+                Log::error() << "Error " << i << ".\n";
+                Log::warning() << "Warning " << i << ".\n";
+            }
+        }
+        Log::setMaxErrors(0);
+
+        t.succeedIf(context.errorCount() == 5 && context.warningCount() == 5 &&
+                    context.diagnostics().size() == 7 &&
+                    context.text().find("Error: Error 1.\n") != std::string::npos &&
+                    context.text().find("Error 2.") == std::string::npos &&
+                    context.text().find("Warning 4.") != std::string::npos &&
+                    context.text().find("Too many errors; 3 more were not shown.\n") != std::string::npos);
+    };
+
+    UnitTest(MergeKeepsOrder, t) {
+        Log::Context outer;
+        Log::Context inner;
+        {
+            Log::Scope logScope{ inner };
+
+            Log::error() << "Second.\n";
+        }
+        {
+            Log::Scope logScope{ outer };
+
+            Log::warning() << "First.\n";
+            Log::merge(inner);
+            Log::error() << "Third.\n";
+        }
+        t.succeedIf(outer.errorCount() == 2 && outer.warningCount() == 1 &&
+                    inner.diagnostics().empty() &&
+                    outer.text() == "Warning: First.\nError: Second.\nError: Third.\n");
+    };
+
+    return RunTests();
+}
@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "../ObjectFile.h"
+#include "UnitTest.h"
+
+static std::string TempPath(const char* name) {
+    return "/tmp/lc3-" + std::to_string(getpid()) + "-" + name + ".o";
+}
+
+int main() {
+    UnitTest(RoundTrip, t) {
+        ObjectFile object;
+        object.sections.push_back({ 0x3000, { 0x1234, 0x0000, 0xE000 }, {} });
+        object.sections[0].relocations.push_back({ 2, ObjectFile::RelocationType::PcOffset9, 1 });
+        object.symbols.push_back({ "START", ObjectFile::Binding::Exported, 0, 0 });
+        object.symbols.push_back({ "PRINT", ObjectFile::Binding::Imported, 0, 0 });
+
+        std::string path = TempPath("roundtrip");
+        bool writeStatus = object.write(path.c_str());
+        auto readBack = ObjectFile::read(path.c_str());
+        std::remove(path.c_str());
+
+        t.succeedIf(writeStatus && readBack &&
+                    readBack->sections.size() == 1 &&
+                    readBack->sections[0].origin.value() == 0x3000 &&
+                    readBack->sections[0].words.size() == 3 &&
+                    readBack->sections[0].words[2].value() == 0xE000 &&
+                    readBack->sections[0].relocations.size() == 1 &&
+                    readBack->sections[0].relocations[0].type ==
+                        ObjectFile::RelocationType::PcOffset9 &&
+                    readBack->symbols.size() == 2 &&
+                    readBack->symbols[1].name == "PRINT" &&
+                    readBack->symbols[1].binding == ObjectFile::Binding::Imported);
+    };
+
+    UnitTest(RejectsBadSymbolIndex, t) {
+        ObjectFile object;
+        object.sections.push_back({ 0x3000, { 0x0000 }, {} });
+        object.sections[0].relocations.push_back({ 0, ObjectFile::RelocationType::Word, 5 });
+
+        std::string path = TempPath("badindex");
+        object.write(path.c_str());
+        auto readBack = ObjectFile::read(path.c_str());
+        std::remove(path.c_str());
+
+        t.succeedIf(!readBack);
+    };
+
+    UnitTest(RejectsOtherFiles, t) {
+        std::string path = TempPath("notobject");
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("\x30\x00\x12\x34", file);
+        std::fclose(file);
+
+        auto readBack = ObjectFile::read(path.c_str());
+        std::remove(path.c_str());
+
+        t.succeedIf(!readBack && !ObjectFile::read(path.c_str()));
+    };
+
+    return RunTests();
+}
@@ -0,0 +1,182 @@
+#include <string>
+#include "../Log.h"
+#include "../language/SymbolTable.h"
+#include "../language/Optimizer.h"
+#include "../language/LiteralPools.h"
+#include "AssemblyFixture.h"
+#include "UnitTest.h"
+
+using LC3::Language::SyntaxTreeNode;
+using LC3::Language::SymbolInterner;
+using LC3::Language::SymbolTable;
+using LC3::Language::Optimizer;
+using LC3::Language::LiteralPools;
+
+static bool Optimize(SyntaxTreeNode& root, const SymbolInterner& symbols) {
+    auto symTable = SymbolTable::make(root, symbols);
+
+    if (symTable) {
+        Optimizer::optimize(root, *symTable);
+    }
+    return symTable.has_value();
+}
+
+// Optimizes a program with literals, then places its pools, as lc3asm
+// does.
+static bool OptimizeAndPlace(SyntaxTreeNode& root, const SymbolInterner& symbols) {
+    return Optimize(root, symbols) && LiteralPools::place(root);
+}
+
+// Checks that the program optimizes to the same output as expected
+// assembles to.
+static bool Optimizes(const std::string& program, const std::string& expected) {
+    return SameOutput(program, expected, Optimize);
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(ThreadsBranches, t) {
+        t.succeedIf(Optimizes(".ORIG x3000\n"
+                              "A   BRz B\n"
+                              "    BRp C\n"
+                              "    HALT\n"
+                              "B   BRnzp C\n"
+                              "C   BRzp D\n"
+                              "D   HALT\n"
+                              ".END\n",
+                              ".ORIG x3000\n"
+                              "A   BRz D\n"
+                              "    BRp D\n"
+                              "    HALT\n"
+                              "D   HALT\n"
+                              ".END\n"));
+    };
+
+    UnitTest(DropsUnreachableCode, t) {
+        t.succeedIf(Optimizes(".ORIG x3000\n"
+                              "    BRnzp A\n"
+                              "    ADD R0, R0, #1\n"
+                              "    NOT R1, R1\n"
+                              "A   RET\n"
+                              "    HALT\n"
+                              "B   HALT\n"
+                              "    .FILL B\n"
+                              ".END\n",
+                              ".ORIG x3000\n"
+                              "A   RET\n"
+                              "B   HALT\n"
+                              "    .FILL B\n"
+                              ".END\n"));
+    };
+
+    UnitTest(DropsOverwrittenInstructions, t) {
+        t.succeedIf(Optimizes(".ORIG x3000\n"
+                              "    AND R1, R1, #0\n"
+                              "    ADD R1, R2, #5\n"
+                              "    AND R3, R3, #0\n"
+                              "    ADD R3, R3, #2\n"
+                              "    ADD R4, R4, #0\n"
+                              "    LDR R0, R5, #1\n"
+                              "    ADD R4, R4, #0\n"
+                              "    BRz A\n"
+                              "A   HALT\n"
+                              ".END\n",
+                              ".ORIG x3000\n"
+                              "    ADD R1, R2, #5\n"
+                              "    AND R3, R3, #0\n"
+                              "    ADD R3, R3, #2\n"
+                              "    LDR R0, R5, #1\n"
+                              "    ADD R4, R4, #0\n"
+                              "A   HALT\n"
+                              ".END\n"));
+    };
+
+    UnitTest(DropsRepeatedTests, t) {
+        t.succeedIf(Optimizes(".ORIG x3000\n"
+                              "    LD R0, N\n"
+                              "    ADD R0, R0, #0\n"
+                              "    BRz A\n"
+                              "    ADD R1, R1, #0\n"
+                              "A   HALT\n"
+                              "N   .FILL #3\n"
+                              ".END\n",
+                              ".ORIG x3000\n"
+                              "    LD R0, N\n"
+                              "    BRz A\n"
+                              "    ADD R1, R1, #0\n"
+                              "A   HALT\n"
+                              "N   .FILL #3\n"
+                              ".END\n"));
+    };
+
+    UnitTest(KeepsDataLabels, t) {
+        t.succeedIf(Optimizes(".ORIG x3000\n"
+                              "    LD R0, A\n"
+                              "    BRnzp B\n"
+                              "A   AND R1, R1, #0\n"
+                              "B   LD R1, A\n"
+                              "    HALT\n"
+                              ".END\n",
+                              ".ORIG x3000\n"
+                              "    LD R0, A\n"
+                              "    BRnzp B\n"
+                              "A   AND R1, R1, #0\n"
+                              "B   LD R1, A\n"
+                              "    HALT\n"
+                              ".END\n"));
+    };
+
+    UnitTest(NumericAddressesKeepLayout, t) {
+        t.succeedIf(Optimizes(".ORIG x3000\n"
+                              "    BRnzp x3003\n"
+                              "    ADD R0, R0, #1\n"
+                              "    ADD R0, R0, #1\n"
+                              "    HALT\n"
+                              ".END\n",
+                              ".ORIG x3000\n"
+                              "    BRnzp x3003\n"
+                              "    ADD R0, R0, #1\n"
+                              "    ADD R0, R0, #1\n"
+                              "    HALT\n"
+                              ".END\n"));
+    };
+
+    UnitTest(NumericDataKeepsLayout, t) {
+        t.succeedIf(Optimizes(".ORIG x3000\n"
+                              "    BRnzp A\n"
+                              "    ADD R0, R0, #1\n"
+                              "A   HALT\n"
+                              "    .FILL x3002\n"
+                              ".END\n",
+                              ".ORIG x3000\n"
+                              "    BRnzp A\n"
+                              "    ADD R0, R0, #1\n"
+                              "A   HALT\n"
+                              "    .FILL x3002\n"
+                              ".END\n"));
+    };
+
+    UnitTest(KeepsLiteralLabels, t) {
+        t.succeedIf(SameOutput(".ORIG x3000\n"
+                               "    LD R0, =A\n"
+                               "    HALT\n"
+                               "A   ADD R1, R1, #0\n"
+                               "    AND R2, R2, #0\n"
+                               "    HALT\n"
+                               ".END\n",
+                               ".ORIG x3000\n"
+                               "    LD R0, x3002\n"
+                               "    HALT\n"
+                               "    .FILL A\n"
+                               "A   ADD R1, R1, #0\n"
+                               "    AND R2, R2, #0\n"
+                               "    HALT\n"
+                               ".END\n",
+                               OptimizeAndPlace, true));
+    };
+
+    return RunTests();
+}
@@ -0,0 +1,171 @@
+#include <string>
+#include "../Log.h"
+#include "../language/SymbolTable.h"
+#include "../language/Relaxer.h"
+#include "../language/LiteralPools.h"
+#include "AssemblyFixture.h"
+#include "UnitTest.h"
+
+using LC3::Language::SyntaxTreeNode;
+using LC3::Language::SymbolInterner;
+using LC3::Language::SymbolTable;
+using LC3::Language::Relaxer;
+using LC3::Language::LiteralPools;
+
+static bool Relax(SyntaxTreeNode& root, const SymbolInterner& symbols) {
+    auto symTable = SymbolTable::make(root, symbols);
+
+    if (symTable) {
+        Relaxer::relax(root, *symTable);
+    }
+    return symTable.has_value();
+}
+
+// Relaxes a program with literals, places its pools, then relaxes what
+// they put out of reach, as lc3asm does.
+static bool RelaxAroundPools(SyntaxTreeNode& root, const SymbolInterner& symbols) {
+    return Relax(root, symbols) && LiteralPools::place(root) && Relax(root, symbols);
+}
+
+// Checks that the program relaxes to the same output as expected
+// assembles to.
+static bool Relaxes(const std::string& program, const std::string& expected) {
+    return SameOutput(program, expected, Relax);
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(RelaxesCascadingBranches, t) {
+        t.succeedIf(Relaxes(".ORIG x3000\n"
+                            "     BRz NEAR\n"
+                            "     BRz FAR\n"
+                            "     .BLKW 254\n"
+                            "NEAR HALT\n"
+                            "     .BLKW 300\n"
+                            "FAR  HALT\n"
+                            ".END\n",
+                            ".ORIG x3000\n"
+                            "     BRnp x3004\n"
+                            "     LD R7, x3003\n"
+                            "     JMP R7\n"
+                            "     .FILL NEAR\n"
+                            "     BRnp x3008\n"
+                            "     LD R7, x3007\n"
+                            "     JMP R7\n"
+                            "     .FILL FAR\n"
+                            "     .BLKW 254\n"
+                            "NEAR HALT\n"
+                            "     .BLKW 300\n"
+                            "FAR  HALT\n"
+                            ".END\n"));
+    };
+
+    UnitTest(RelaxesUnconditionalBranches, t) {
+        t.succeedIf(Relaxes(".ORIG x3000\n"
+                            "TOP  HALT\n"
+                            "     .BLKW 300\n"
+                            "     BRnzp TOP\n"
+                            ".END\n",
+                            ".ORIG x3000\n"
+                            "TOP  HALT\n"
+                            "     .BLKW 300\n"
+                            "     LD R7, x312F\n"
+                            "     JMP R7\n"
+                            "     .FILL TOP\n"
+                            ".END\n"));
+    };
+
+    UnitTest(RelaxesCalls, t) {
+        t.succeedIf(Relaxes(".ORIG x3000\n"
+                            "     JSR SUB\n"
+                            "     HALT\n"
+                            "     .BLKW 1100\n"
+                            "SUB  RET\n"
+                            ".END\n",
+                            ".ORIG x3000\n"
+                            "     LD R7, x3003\n"
+                            "     JSRR R7\n"
+                            "     BRnzp x3004\n"
+                            "     .FILL SUB\n"
+                            "     HALT\n"
+                            "     .BLKW 1100\n"
+                            "SUB  RET\n"
+                            ".END\n"));
+    };
+
+    UnitTest(RelaxesLoads, t) {
+        t.succeedIf(Relaxes(".ORIG x3000\n"
+                            "     LD R0, N\n"
+                            "     LDI R1, P\n"
+                            "     LEA R2, N\n"
+                            "     ST R0, N\n"
+                            "     HALT\n"
+                            "     .BLKW 300\n"
+                            "N    .FILL #5\n"
+                            "P    .FILL N\n"
+                            ".END\n",
+                            ".ORIG x3000\n"
+                            "     LDI R0, x3002\n"
+                            "     BRnzp x3003\n"
+                            "     .FILL N\n"
+                            "     LDI R1, x3006\n"
+                            "     LDR R1, R1, #0\n"
+                            "     BRnzp x3007\n"
+                            "     .FILL P\n"
+                            "     LD R2, x3009\n"
+                            "     BRnzp x300A\n"
+                            "     .FILL N\n"
+                            "     STI R0, x300C\n"
+                            "     BRnzp x300D\n"
+                            "     .FILL N\n"
+                            "     HALT\n"
+                            "     .BLKW 300\n"
+                            "N    .FILL #5\n"
+                            "P    .FILL N\n"
+                            ".END\n"));
+    };
+
+    UnitTest(LeavesNearLabels, t) {
+        t.succeedIf(Relaxes(".ORIG x3000\n"
+                            "     BRz A\n"
+                            "     LD R0, N\n"
+                            "     .BLKW 200\n"
+                            "A    HALT\n"
+                            "N    .FILL #5\n"
+                            ".END\n",
+                            ".ORIG x3000\n"
+                            "     BRz A\n"
+                            "     LD R0, N\n"
+                            "     .BLKW 200\n"
+                            "A    HALT\n"
+                            "N    .FILL #5\n"
+                            ".END\n"));
+    };
+
+    UnitTest(RelaxesBranchesPastPools, t) {
+        t.succeedIf(SameOutput(".ORIG x3000\n"
+                               "     BRz FAR\n"
+                               "     LD R0, =#5\n"
+                               "     BRnzp SKIP\n"
+                               "SKIP .BLKW 253\n"
+                               "FAR  HALT\n"
+                               ".END\n",
+                               ".ORIG x3000\n"
+                               "     BRnp x3004\n"
+                               "     LD R7, x3003\n"
+                               "     JMP R7\n"
+                               "     .FILL FAR\n"
+                               "     LD R0, x3006\n"
+                               "     BRnzp SKIP\n"
+                               "     .FILL #5\n"
+                               "SKIP .BLKW 253\n"
+                               "FAR  HALT\n"
+                               ".END\n",
+                               RelaxAroundPools, true));
+    };
+
+    return RunTests();
+}
@@ -0,0 +1,100 @@
+#include <vector>
+#include "../Log.h"
+#include "../language/SectionMap.h"
+#include "UnitTest.h"
+
+using LC3::Language::SectionMap;
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(Disjoint, t) {
+        SectionMap sectionMap;
+
+        t.succeedIf(!sectionMap.add(0x3000, 0x10) &&
+                    !sectionMap.add(0x0000, 0x100) &&
+                    !sectionMap.add(0x4000, 0x10));
+    };
+
+    UnitTest(Adjacent, t) {
+        SectionMap sectionMap;
+
+        t.succeedIf(!sectionMap.add(0x3000, 0x10) &&
+                    !sectionMap.add(0x3010, 0x10) &&
+                    !sectionMap.add(0x2FF0, 0x10));
+    };
+
+    UnitTest(OverlapsEarlierAddresses, t) {
+        SectionMap sectionMap;
+        sectionMap.add(0x3000, 0x10);
+
+        auto overlapped = sectionMap.add(0x300F, 0x10);
+
+        t.succeedIf(overlapped && overlapped->value() == 0x3000);
+    };
+
+    UnitTest(OverlapsLaterAddresses, t) {
+        SectionMap sectionMap;
+        sectionMap.add(0x3000, 0x10);
+        sectionMap.add(0x4000, 0x10);
+
+        auto overlapped = sectionMap.add(0x3F00, 0x101);
+
+        t.succeedIf(overlapped && overlapped->value() == 0x4000);
+    };
+
+    UnitTest(Contained, t) {
+        SectionMap sectionMap;
+        sectionMap.add(0x3000, 0x100);
+
+        auto overlapped = sectionMap.add(0x3010, 1);
+
+        t.succeedIf(overlapped && overlapped->value() == 0x3000);
+    };
+
+    UnitTest(EmptySection, t) {
+        SectionMap sectionMap;
+        sectionMap.add(0x3000, 0x10);
+
+        t.succeedIf(!sectionMap.add(0x3008, 0));
+    };
+
+    UnitTest(FinishFillsLengths, t) {
+        std::vector<LC3::Word> image = { 0x3000, 0, 1, 2, 3, 0x0200, 0, 4 };
+        std::vector<SectionMap::Section> sections = { { 0, {} }, { 5, {} } };
+
+        t.succeedIf(SectionMap::finish(image, sections) &&
+                    image[1].value() == 3 && image[6].value() == 1);
+    };
+
+    UnitTest(FinishReportsOverlap, t) {
+        std::vector<LC3::Word> image = { 0x3000, 0, 1, 2, 3, 0x3002, 0, 4 };
+        std::vector<SectionMap::Section> sections = { { 0, {} }, { 5, {} } };
+        size_t errorsBefore = LogContext.errorCount();
+
+        t.succeedIf(!SectionMap::finish(image, sections) &&
+                    LogContext.errorCount() == errorsBefore + 1);
+    };
+
+    UnitTest(FinishReportsPastMemory, t) {
+        std::vector<LC3::Word> image = { 0xFFFE, 0, 1, 2, 3, 4 };
+        std::vector<SectionMap::Section> sections = { { 0, {} } };
+        size_t errorsBefore = LogContext.errorCount();
+
+        t.succeedIf(!SectionMap::finish(image, sections) &&
+                    LogContext.errorCount() == errorsBefore + 1);
+    };
+
+    UnitTest(FinishReportsFullMemory, t) {
+        std::vector<LC3::Word> image(SectionMap::HeaderSize + LC3::Word::maxValue + 1);
+        std::vector<SectionMap::Section> sections = { { 0, {} } };
+        size_t errorsBefore = LogContext.errorCount();
+
+        t.succeedIf(!SectionMap::finish(image, sections) &&
+                    LogContext.errorCount() == errorsBefore + 1);
+    };
+
+    return RunTests();
+}
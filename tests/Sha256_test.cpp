@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <string>
+#include "../util/Sha256.h"
+#include "UnitTest.h"
+
+using Util::Sha256;
+
+static std::string HexDigest(const std::string& data) {
+    Sha256 hasher;
+    hasher.update(data.data(), data.size());
+
+    return Sha256::toHex(hasher.finish());
+}
+
+int main() {
+    UnitTest(Empty, t) {
+        t.succeedIf(HexDigest("") ==
+                    "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    };
+
+    UnitTest(ShortMessage, t) {
+        t.succeedIf(HexDigest("abc") ==
+                    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    };
+
+    UnitTest(TwoBlockPadding, t) {
+        t.succeedIf(HexDigest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+                    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    };
+
+    UnitTest(SplitUpdates, t) {
+        std::string data(1000, 'a');
+        Sha256 hasher;
+
+        for (size_t pos = 0; pos < data.size(); pos += 7) {
+            hasher.update(data.data() + pos, std::min<size_t>(7, data.size() - pos));
+        }
+        t.succeedIf(Sha256::toHex(hasher.finish()) == HexDigest(data));
+    };
+
+    UnitTest(MillionA, t) {
+        t.succeedIf(HexDigest(std::string(1000000, 'a')) ==
+                    "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    };
+
+    return RunTests();
+}
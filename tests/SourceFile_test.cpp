@@ -0,0 +1,49 @@
+#include <util/StringView.h>
+#include "../language/SourceFile.h"
+#include "UnitTest.h"
+
+using Util::StringView;
+using LC3::Language::SourceFile;
+
+int main() {
+    UnitTest(FirstLine, t) {
+        SourceFile srcFile{ "ADD R1, R1, #1\nHALT\n"_sv };
+        auto pos = srcFile.position({ 4 });
+
+        t.succeedIf(pos.lineNum == 1 && pos.lineOffset == 4 &&
+                    pos.line == "ADD R1, R1, #1");
+    };
+
+    UnitTest(LaterLine, t) {
+        SourceFile srcFile{ "a\nbb\nccc\n"_sv };
+        auto pos = srcFile.position({ 6 });
+
+        t.succeedIf(pos.lineNum == 3 && pos.lineOffset == 1 && pos.line == "ccc");
+    };
+
+    UnitTest(Linebreak, t) {
+        SourceFile srcFile{ "a\nbb\n"_sv };
+        auto pos = srcFile.position({ 4 });
+
+        t.succeedIf(pos.lineNum == 2 && pos.lineOffset == 2 && pos.line == "bb");
+    };
+
+    UnitTest(EndOfText, t) {
+        SourceFile srcFile{ "a\nbb"_sv };
+        auto pos = srcFile.position({ 4 });
+
+        t.succeedIf(pos.lineNum == 2 && pos.lineOffset == 2 && pos.line == "bb");
+    };
+
+    UnitTest(ActiveScope, t) {
+        SourceFile srcFile{ "a"_sv };
+        bool wasActive = false;
+        {
+            SourceFile::Scope scope{ srcFile };
+            wasActive = SourceFile::active() == &srcFile;
+        }
+        t.succeedIf(wasActive && SourceFile::active() == nullptr);
+    };
+
+    return RunTests();
+}
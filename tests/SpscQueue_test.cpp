@@ -0,0 +1,71 @@
+#include <thread>
+#include <vector>
+#include <util/SpscQueue.h>
+#include "UnitTest.h"
+
+using Util::SpscQueue;
+
+int main() {
+    UnitTest(Capacity, t) {
+        SpscQueue<int> queue{ 3 };
+        int values[] = { 1, 2, 3, 4 };
+        size_t numPushed = 0;
+
+        for (int& value : values) {
+            numPushed += queue.tryPush(value) ? 1 : 0;
+        }
+        t.succeedIf(queue.capacity() == 3 && numPushed == 3);
+    };
+
+    UnitTest(FifoOrder, t) {
+        SpscQueue<int> queue{ 4 };
+        int a = 1, b = 2, c = 3;
+        int x = 0, y = 0, z = 0;
+
+        queue.tryPush(a);
+        queue.tryPush(b);
+        queue.tryPush(c);
+
+        bool popped = queue.tryPop(x) && queue.tryPop(y) && queue.tryPop(z);
+
+        t.succeedIf(popped && x == 1 && y == 2 && z == 3 && !queue.tryPop(x));
+    };
+
+    UnitTest(DrainAfterClose, t) {
+        SpscQueue<int> queue{ 4 };
+        int value = 0;
+
+        queue.push(7);
+        queue.close();
+
+        bool first = queue.pop(value);
+        bool second = queue.pop(value);
+
+        t.succeedIf(first && value == 7 && !second && !queue.push(8));
+    };
+
+    UnitTest(TwoThreads, t) {
+        constexpr int NumValues = 100000;
+        SpscQueue<std::vector<int>> queue{ 16 };
+
+        std::thread producer([&queue]() {
+            for (int i = 0; i < NumValues; ++i) {
+                queue.push(std::vector<int>{ i });
+            }
+            queue.close();
+        });
+        std::vector<int> received;
+        int expected = 0;
+        bool inOrder = true;
+
+        while (queue.pop(received)) {
+            inOrder = inOrder && received.size() == 1 && received[0] == expected;
+            ++expected;
+        }
+        producer.join();
+
+        t.succeedIf(inOrder && expected == NumValues);
+    };
+
+    return RunTests();
+}
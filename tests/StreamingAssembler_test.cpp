@@ -0,0 +1,132 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include "../Log.h"
+#include "../LC3Writer.h"
+#include "../language/SourceFile.h"
+#include "../language/SymbolInterner.h"
+#include "../language/Parser.h"
+#include "../language/Assembler.h"
+#include "../language/StreamingAssembler.h"
+#include "UnitTest.h"
+
+using LC3::Language::SourceFile;
+using LC3::Language::SymbolInterner;
+using LC3::Language::Parser;
+using LC3::Language::Assembler;
+using LC3::Language::StreamingAssembler;
+
+static const std::string Program =
+    ".ORIG x3000\n"
+    "        LD R1, COUNT\n"
+    "LOOP    ADD R0, R0, #1\n"
+    "        ADD R1, R1, #-1\n"
+    "        BRp LOOP\n"
+    "        LEA R2, MSG\n"
+    "        HALT\n"
+    "COUNT   .FILL #5\n"
+    "MSG     .STRINGZ \"hi\"\n"
+    "        .END\n";
+
+static std::string TempPath(const std::string& name) {
+    return "/tmp/lc3-" + std::to_string(getpid()) + "-" + name + ".obj";
+}
+
+static std::string ReadFile(const std::string& path) {
+    std::ifstream inFile(path, std::ios::binary);
+
+    return std::string{ std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>() };
+}
+
+// Assembles text both ways, and checks that they agree on the outcome and,
+// if it succeeded, on the output.
+static bool SameAsSinglePass(const std::string& text, bool& succeeded) {
+    SourceFile srcFile{ text };
+    SourceFile::Scope srcScope{ srcFile };
+
+    std::string expectedPath = TempPath("expected");
+    std::string streamedPath = TempPath("streamed");
+    bool expectedStatus = false;
+    bool streamedStatus = false;
+    {
+        SymbolInterner symbols;
+        LC3Writer writer(expectedPath.c_str());
+        auto asTree = Parser::parse(text, symbols);
+
+        expectedStatus = asTree && Assembler::assemble(*asTree, symbols, writer);
+    }
+    {
+        SymbolInterner symbols;
+        LC3Writer writer(streamedPath.c_str());
+
+        streamedStatus = StreamingAssembler::assemble(srcFile, symbols, writer);
+    }
+    bool sameOutput = ReadFile(expectedPath) == ReadFile(streamedPath);
+
+    unlink(expectedPath.c_str());
+    unlink(streamedPath.c_str());
+
+    succeeded = streamedStatus;
+
+    return expectedStatus == streamedStatus && (!expectedStatus || sameOutput);
+}
+
+static Log::Context LogContext;
+
+int main() {
+    Log::Scope logScope{ LogContext };
+
+    UnitTest(SmallProgram, t) {
+        bool succeeded = false;
+
+        t.succeedIf(SameAsSinglePass(Program, succeeded) && succeeded);
+    };
+
+    UnitTest(ManyBatches, t) {
+        std::string text = ".ORIG x3000\n";
+        size_t numLines = 4 * StreamingAssembler::TokenBatchSize;
+
+        // Each line refers to the label on the next, which may be in the
+        // next batch.
+        for (size_t i = 0; i < numLines; ++i) {
+            text += "L" + std::to_string(i) + " BRp L" + std::to_string(i + 1) + "\n";
+        }
+        text += "L" + std::to_string(numLines) + " HALT\n        .END\n";
+
+        bool succeeded = false;
+
+        t.succeedIf(SameAsSinglePass(text, succeeded) && succeeded);
+    };
+
+    UnitTest(Sections, t) {
+        std::string text = Program + ".ORIG x4000\n        .FILL LOOP\n        .END\n";
+        bool succeeded = false;
+
+        t.succeedIf(SameAsSinglePass(text, succeeded) && succeeded);
+    };
+
+    UnitTest(UndefinedSymbol, t) {
+        std::string text = Program;
+        text.replace(text.find("MSG\n"), 3, "NOPE");
+
+        bool succeeded = true;
+
+        t.succeedIf(SameAsSinglePass(text, succeeded) && !succeeded);
+    };
+
+    UnitTest(SyntaxError, t) {
+        bool succeeded = true;
+
+        t.succeedIf(SameAsSinglePass(Program + "        ADD R0,,\n", succeeded) && !succeeded);
+    };
+
+    UnitTest(OverlappingSections, t) {
+        std::string text = Program + ".ORIG x3001\n        .FILL #1\n        .END\n";
+        bool succeeded = true;
+
+        t.succeedIf(SameAsSinglePass(text, succeeded) && !succeeded);
+    };
+
+    return RunTests();
+}
@@ -1,3 +1,4 @@
+#include <string>
 #include <util/CharClass.h>
 #include <util/StringTokenizer.h>
 #include <util/StringView.h>
@@ -80,6 +81,54 @@ int main() {
         t.succeedIf(readResult == "aaa");
     };
 
+    // The inputs below are long enough to go through the vectorized scan
+    // in CharScan.cpp as well as its byte-by-byte tail.
+    UnitTest(SkipUntilNotLong, t) {
+        std::string src(100, ' ');
+        src += "x";
+        StringTokenizer tok{ src };
+        tok.skipUntilNot(CharClass(" \t"));
+
+        t.succeedIf(tok.position() == 100 && tok.peekChar() == 'x');
+    };
+
+    UnitTest(ReadUntilNotRanges, t) {
+        std::string word = "abc_DEF_0123456789_ghijklmnopqrstuvwxyz_ABCDEFGH";
+        std::string src = word + ",rest";
+        StringTokenizer tok{ src };
+        CharClass isWord("abcdefghijklmnopqrstuvwxyz"
+                         "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                         "0123456789_");
+
+        t.succeedIf(tok.readUntilNot(isWord) == StringView(word));
+    };
+
+    UnitTest(SkipUntilHighBytes, t) {
+        std::string src(40, '\xF0');
+        src += "\n";
+        StringTokenizer tok{ src };
+        tok.skipUntil(CharClass("\n"));
+
+        t.succeedIf(tok.position() == 40);
+    };
+
+    UnitTest(SkipUntilFragmented, t) {
+        std::string src(70, 'b');
+        src += "a";
+        StringTokenizer tok{ src };
+        tok.skipUntil(CharClass("acegikmoq"));
+
+        t.succeedIf(tok.position() == 70);
+    };
+
+    UnitTest(SkipUntilNoMatch, t) {
+        std::string src(50, 'a');
+        StringTokenizer tok{ src };
+        tok.skipUntil(CharClass(";"));
+
+        t.succeedIf(tok.finished());
+    };
+
     UnitTest(NextToken, t) {
         StringView src = " a + b + c "_sv;
         StringTokenizer tok{ src };
@@ -0,0 +1,41 @@
+#include <util/StringView.h>
+#include "../language/SymbolInterner.h"
+#include "UnitTest.h"
+
+using Util::StringView;
+using LC3::Language::SymbolInterner;
+
+int main() {
+    UnitTest(DenseIds, t) {
+        SymbolInterner symbols;
+
+        t.succeedIf(symbols.intern("LOOP") == 0 &&
+                    symbols.intern("DONE") == 1 &&
+                    symbols.intern("VAL") == 2 &&
+                    symbols.size() == 3);
+    };
+
+    UnitTest(Repeated, t) {
+        SymbolInterner symbols;
+        auto firstId = symbols.intern("LOOP");
+        symbols.intern("DONE");
+
+        t.succeedIf(symbols.intern("LOOP") == firstId && symbols.size() == 2);
+    };
+
+    UnitTest(CaseSensitive, t) {
+        SymbolInterner symbols;
+
+        t.succeedIf(symbols.intern("loop") != symbols.intern("LOOP"));
+    };
+
+    UnitTest(Name, t) {
+        SymbolInterner symbols;
+        symbols.intern("LOOP");
+        auto doneId = symbols.intern("DONE");
+
+        t.succeedIf(symbols.name(doneId) == "DONE");
+    };
+
+    return RunTests();
+}
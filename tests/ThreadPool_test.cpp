@@ -0,0 +1,72 @@
+#include <atomic>
+#include <vector>
+#include <util/ThreadPool.h>
+#include "UnitTest.h"
+
+using Util::ThreadPool;
+
+int main() {
+    UnitTest(RunsEveryJob, t) {
+        std::atomic<size_t> numRun{ 0 };
+        ThreadPool pool{ 4 };
+
+        for (size_t i = 0; i < 1000; ++i) {
+            pool.submit([&numRun]() { ++numRun; });
+        }
+        pool.wait();
+
+        t.succeedIf(numRun == 1000);
+    };
+
+    UnitTest(JobsWriteOwnSlots, t) {
+        std::vector<size_t> results(256, 0);
+        ThreadPool pool{ 3 };
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            pool.submit([&results, i]() { results[i] = i * i; });
+        }
+        pool.wait();
+
+        bool allSet = true;
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            allSet = allSet && results[i] == i * i;
+        }
+        t.succeedIf(allSet);
+    };
+
+    UnitTest(UnevenJobsAreStolen, t) {
+        std::atomic<size_t> numRun{ 0 };
+        ThreadPool pool{ 2 };
+
+        // Every other job is slow, so the worker that owns them falls behind
+        // and the other has to steal to finish.
+        for (size_t i = 0; i < 64; ++i) {
+            pool.submit([&numRun, i]() {
+                if (i % 2 == 0) {
+                    volatile size_t sink = 0;
+
+                    for (size_t j = 0; j < 100000; ++j) {
+                        sink = sink + j;
+                    }
+                }
+                ++numRun;
+            });
+        }
+        pool.wait();
+
+        t.succeedIf(numRun == 64);
+    };
+
+    UnitTest(ZeroThreads, t) {
+        ThreadPool pool{ 0 };
+        bool didRun = false;
+
+        pool.submit([&didRun]() { didRun = true; });
+        pool.wait();
+
+        t.succeedIf(pool.size() == 1 && didRun);
+    };
+
+    return RunTests();
+}
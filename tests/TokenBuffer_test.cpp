@@ -0,0 +1,60 @@
+#include <util/StringView.h>
+#include "../language/TokenBuffer.h"
+#include "UnitTest.h"
+
+using Util::StringView;
+using LC3::Language::TokenType;
+using LC3::Language::TokenBuffer;
+
+int main() {
+    UnitTest(Lookahead, t) {
+        TokenBuffer tokens{ "label: ADD R1, R2, #3\n"_sv };
+
+        t.succeedIf(tokens.peek(1).type == TokenType::Colon &&
+                    tokens.peek(2).str == "ADD" &&
+                    (*tokens).str == "label");
+    };
+
+    UnitTest(Consume, t) {
+        TokenBuffer tokens{ "a b c"_sv };
+        tokens += 2;
+
+        t.succeedIf((*tokens).str == "c" && tokens.position() == 2);
+    };
+
+    UnitTest(EndToken, t) {
+        TokenBuffer tokens{ "a\n"_sv };
+
+        t.succeedIf(tokens.size() == 3 &&
+                    tokens.peek(2).type == TokenType::End);
+    };
+
+    UnitTest(PeekPastEnd, t) {
+        TokenBuffer tokens{ "a"_sv };
+
+        t.succeedIf(tokens.peek(100).type == TokenType::End);
+    };
+
+    UnitTest(ConsumePastEnd, t) {
+        TokenBuffer tokens{ "a b"_sv };
+        tokens += 100;
+
+        t.succeedIf(tokens.isDone() && !tokens);
+    };
+
+    UnitTest(EmptySource, t) {
+        TokenBuffer tokens{ ""_sv };
+
+        t.succeedIf(tokens.size() == 1 && tokens.isDone());
+    };
+
+    UnitTest(BaseOffset, t) {
+        TokenBuffer tokens{ "ADD R1\nHALT"_sv, 100 };
+
+        t.succeedIf(tokens[0].location.offset == 100 &&
+                    tokens[2].location.offset == 106 &&
+                    tokens[3].location.offset == 107);
+    };
+
+    return RunTests();
+}
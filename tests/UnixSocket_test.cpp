@@ -0,0 +1,86 @@
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "../util/UnixSocket.h"
+#include "UnitTest.h"
+
+using Util::UnixSocket;
+
+static std::string SocketPath(const char* name) {
+    return "/tmp/lc3-" + std::to_string(getpid()) + "-" + name + ".sock";
+}
+
+int main() {
+    UnitTest(RoundTrip, t) {
+        std::string path = SocketPath("roundtrip");
+        UnixSocket listener = UnixSocket::listen(path);
+
+        std::thread client([&path]() {
+            UnixSocket sock = UnixSocket::connect(path);
+            char reply[5] = {};
+
+            sock.writeAll("ping", 4);
+            sock.readAll(reply, 4);
+            sock.writeAll(reply, 4);
+        });
+        UnixSocket server = listener.accept();
+        char request[4] = {};
+        char echo[4] = {};
+
+        bool status = server.readAll(request, 4) &&
+                      server.writeAll("pong", 4) &&
+                      server.readAll(echo, 4);
+        client.join();
+        unlink(path.c_str());
+
+        t.succeedIf(listener && status &&
+                    std::string(request, 4) == "ping" &&
+                    std::string(echo, 4) == "pong");
+    };
+
+    UnitTest(ReplacesStaleSocket, t) {
+        std::string path = SocketPath("stale");
+
+        UnixSocket first = UnixSocket::listen(path);
+        first.close();
+
+        UnixSocket second = UnixSocket::listen(path);
+        unlink(path.c_str());
+
+        t.succeedIf(second.isOpen());
+    };
+
+    UnitTest(ConnectFailure, t) {
+        UnixSocket sock = UnixSocket::connect(SocketPath("missing"));
+
+        t.succeedIf(!sock);
+    };
+
+    UnitTest(ReadAfterPeerCloses, t) {
+        std::string path = SocketPath("closed");
+        UnixSocket listener = UnixSocket::listen(path);
+        UnixSocket client = UnixSocket::connect(path);
+        UnixSocket server = listener.accept();
+        char byte = 0;
+
+        client.close();
+        unlink(path.c_str());
+
+        t.succeedIf(!server.readAll(&byte, 1));
+    };
+
+    UnitTest(ReadTimesOut, t) {
+        std::string path = SocketPath("idle");
+        UnixSocket listener = UnixSocket::listen(path);
+        UnixSocket client = UnixSocket::connect(path);
+        UnixSocket server = listener.accept();
+        char byte = 0;
+
+        unlink(path.c_str());
+
+        t.succeedIf(server.setTimeout(std::chrono::milliseconds{ 50 }) &&
+                    !server.readAll(&byte, 1) && client.isOpen());
+    };
+
+    return RunTests();
+}
@@ -1,22 +1,38 @@
 #pragma once
 
-#include <bitset>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <type_traits>
+#include <utility>
 #include "StringView.h"
 
 namespace Util {
 
+// A set of byte values. Everything is constexpr, so classes declared as
+// constexpr, combinators included, are built by the compiler and a lookup
+// is a single load from a table in read-only data.
 class CharClass {
 private:
     static constexpr size_t SetSize = std::numeric_limits<uint8_t>::max() + 1;
-    using BitSet = std::bitset<SetSize>;
 
 public:
-    explicit CharClass(StringView acceptedChars) {
+    // An inclusive span of byte values that all belong to the class.
+    struct Range {
+        uint8_t first = 0;
+        uint8_t last = 0;
+    };
+
+    // Classes made of at most this many ranges can be tested against many
+    // characters at once (see CharScan.h).
+    static constexpr size_t MaxRanges = 4;
+
+    constexpr explicit CharClass(StringView acceptedChars) {
         for (char c : acceptedChars) {
             set(c, true);
         }
+        computeRanges();
     }
 
     #define HasCallOperator(ObjType) \
@@ -28,39 +44,114 @@ public:
         >
 
     template <typename MapFn, HasCallOperator(MapFn)>
-    explicit CharClass(MapFn&& mapFn) {
+    constexpr explicit CharClass(MapFn&& mapFn) {
         for (size_t i = 0; i < SetSize; ++i) {
             auto charVal = static_cast<char>(i);
 
-            m_bitSet.set(i, mapFn(charVal));
+            m_table[i] = mapFn(charVal);
         }
+        computeRanges();
     }
 
     #undef HasCallOperator
 
+    // Every byte from first to last, inclusive.
+    static constexpr CharClass between(char first, char last) {
+        auto firstVal = static_cast<uint8_t>(first);
+        auto lastVal = static_cast<uint8_t>(last);
+
+        return CharClass {
+            [firstVal, lastVal] (char c) {
+                auto charVal = static_cast<uint8_t>(c);
+
+                return charVal >= firstVal && charVal <= lastVal;
+            }
+        };
+    }
+
+    constexpr CharClass(const CharClass& other) = default;
     CharClass& operator = (const CharClass& other) = delete;
 
-    bool operator () (char c) const {
-        return get(c);
+    constexpr bool operator () (char c) const {
+        return m_table[static_cast<uint8_t>(c)];
     }
 
-    static CharClass combine(const CharClass& classOne, const CharClass& classTwo);
-    static CharClass intersect(const CharClass& classOne, const CharClass& classTwo);
-    static CharClass complement(const CharClass& charClass);
+    constexpr bool hasRanges() const {
+        return m_numRanges <= MaxRanges;
+    }
+    constexpr size_t numRanges() const {
+        return m_numRanges;
+    }
+    constexpr const Range& range(size_t index) const {
+        return m_ranges[index];
+    }
+
+    static constexpr CharClass combine(const CharClass& classOne, const CharClass& classTwo) {
+        return CharClass {
+            [&classOne, &classTwo] (char c) {
+                return classOne(c) || classTwo(c);
+            }
+        };
+    }
+    static constexpr CharClass intersect(const CharClass& classOne, const CharClass& classTwo) {
+        return CharClass {
+            [&classOne, &classTwo] (char c) {
+                return classOne(c) && classTwo(c);
+            }
+        };
+    }
+    static constexpr CharClass complement(const CharClass& charClass) {
+        return CharClass {
+            [&charClass] (char c) {
+                return !charClass(c);
+            }
+        };
+    }
 
 private:
-    bool get(char c) const {
-        return m_bitSet.test(static_cast<uint8_t>(c));
+    constexpr void set(char c, bool value) {
+        m_table[static_cast<uint8_t>(c)] = value;
     }
-    void set(char c, bool value) {
-        m_bitSet.set(static_cast<uint8_t>(c), value);
+
+    constexpr void computeRanges() {
+        m_numRanges = 0;
+
+        for (size_t i = 0; i < SetSize; ++i) {
+            if (!m_table[i]) continue;
+
+            size_t rangeEnd = i;
+
+            while (rangeEnd + 1 < SetSize && m_table[rangeEnd + 1]) {
+                ++rangeEnd;
+            }
+            // Too fragmented to be scanned in bulk. m_numRanges is left above
+            // MaxRanges so that hasRanges() reports it.
+            if (m_numRanges == MaxRanges) {
+                ++m_numRanges;
+
+                return;
+            }
+            m_ranges[m_numRanges].first = static_cast<uint8_t>(i);
+            m_ranges[m_numRanges].last = static_cast<uint8_t>(rangeEnd);
+            ++m_numRanges;
+
+            i = rangeEnd;
+        }
     }
 
-    BitSet m_bitSet;
+    bool m_table[SetSize] = {};
+    std::array<Range, MaxRanges> m_ranges = {};
+    size_t m_numRanges = 0;
 };
 
-CharClass operator ~ (const CharClass& charClass);
-CharClass operator & (const CharClass& classOne, const CharClass& classTwo);
-CharClass operator | (const CharClass& classOne, const CharClass& classTwo);
+constexpr CharClass operator ~ (const CharClass& charClass) {
+    return CharClass::complement(charClass);
+}
+constexpr CharClass operator & (const CharClass& classOne, const CharClass& classTwo) {
+    return CharClass::intersect(classOne, classTwo);
+}
+constexpr CharClass operator | (const CharClass& classOne, const CharClass& classTwo) {
+    return CharClass::combine(classOne, classTwo);
+}
 
 } // namespace Util
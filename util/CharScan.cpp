@@ -0,0 +1,122 @@
+#include <cstddef>
+#include <cstdint>
+#include "CharScan.h"
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CHARSCAN_X86 1
+#endif
+
+namespace Util::CharScan {
+
+static const char* FindFirst_Scalar(const char* curr, const char* end,
+                                    const CharClass& charClass, bool stopValue)
+{
+    while (curr != end && charClass(*curr) != stopValue) {
+        ++curr;
+    }
+    return curr;
+}
+
+#ifdef CHARSCAN_X86
+
+// A byte c lies within [first, last] iff (c - first) <= (last - first) when
+// both sides are treated as unsigned. SSE2 and AVX2 lack an unsigned byte
+// comparison, so "x <= width" is computed as "min(x, width) == x".
+
+static const char* FindFirst_SSE2(const char* curr, const char* end,
+                                  const CharClass& charClass, bool stopValue)
+{
+    constexpr ptrdiff_t BlockSize = 16;
+
+    __m128i firstVecs[CharClass::MaxRanges];
+    __m128i widthVecs[CharClass::MaxRanges];
+    size_t numRanges = charClass.numRanges();
+
+    for (size_t i = 0; i < numRanges; ++i) {
+        const auto& range = charClass.range(i);
+
+        firstVecs[i] = _mm_set1_epi8(static_cast<char>(range.first));
+        widthVecs[i] = _mm_set1_epi8(static_cast<char>(range.last - range.first));
+    }
+    uint32_t flipMask = stopValue ? 0 : 0xFFFF;
+
+    for (; end - curr >= BlockSize; curr += BlockSize) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(curr));
+        __m128i inClass = _mm_setzero_si128();
+
+        for (size_t i = 0; i < numRanges; ++i) {
+            __m128i delta = _mm_sub_epi8(block, firstVecs[i]);
+            __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(delta, widthVecs[i]), delta);
+
+            inClass = _mm_or_si128(inClass, inRange);
+        }
+        uint32_t stopMask = static_cast<uint32_t>(_mm_movemask_epi8(inClass)) ^ flipMask;
+
+        if (stopMask != 0) {
+            return curr + __builtin_ctz(stopMask);
+        }
+    }
+    return FindFirst_Scalar(curr, end, charClass, stopValue);
+}
+
+__attribute__((target("avx2")))
+static const char* FindFirst_AVX2(const char* curr, const char* end,
+                                  const CharClass& charClass, bool stopValue)
+{
+    constexpr ptrdiff_t BlockSize = 32;
+
+    __m256i firstVecs[CharClass::MaxRanges];
+    __m256i widthVecs[CharClass::MaxRanges];
+    size_t numRanges = charClass.numRanges();
+
+    for (size_t i = 0; i < numRanges; ++i) {
+        const auto& range = charClass.range(i);
+
+        firstVecs[i] = _mm256_set1_epi8(static_cast<char>(range.first));
+        widthVecs[i] = _mm256_set1_epi8(static_cast<char>(range.last - range.first));
+    }
+    uint32_t flipMask = stopValue ? 0 : 0xFFFFFFFF;
+
+    for (; end - curr >= BlockSize; curr += BlockSize) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(curr));
+        __m256i inClass = _mm256_setzero_si256();
+
+        for (size_t i = 0; i < numRanges; ++i) {
+            __m256i delta = _mm256_sub_epi8(block, firstVecs[i]);
+            __m256i inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(delta, widthVecs[i]), delta);
+
+            inClass = _mm256_or_si256(inClass, inRange);
+        }
+        uint32_t stopMask = static_cast<uint32_t>(_mm256_movemask_epi8(inClass)) ^ flipMask;
+
+        if (stopMask != 0) {
+            return curr + __builtin_ctz(stopMask);
+        }
+    }
+    // Finish off anything shorter than a full AVX2 block 16 bytes at a time.
+    return FindFirst_SSE2(curr, end, charClass, stopValue);
+}
+
+static bool HasAVX2() {
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+
+    return hasAVX2;
+}
+
+#endif // CHARSCAN_X86
+
+const char* FindFirst(const char* start, const char* end,
+                      const CharClass& charClass, bool stopValue)
+{
+#ifdef CHARSCAN_X86
+    if (charClass.hasRanges()) {
+        return HasAVX2() ?
+            FindFirst_AVX2(start, end, charClass, stopValue) :
+            FindFirst_SSE2(start, end, charClass, stopValue);
+    }
+#endif
+    return FindFirst_Scalar(start, end, charClass, stopValue);
+}
+
+} // namespace Util::CharScan
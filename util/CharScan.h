@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CharClass.h"
+
+namespace Util::CharScan {
+
+// Returns a pointer to the first character in [start, end) whose membership
+// in charClass equals stopValue, or end if there is none.
+//
+// Classes that can be described by a handful of byte ranges are tested 16
+// or 32 characters at a time using SSE2 or AVX2, chosen at runtime based on
+// what the CPU supports. Other classes, and the short tail of the input,
+// go through a plain byte-by-byte loop.
+const char* FindFirst(const char* start, const char* end,
+                      const CharClass& charClass, bool stopValue);
+
+} // namespace Util::CharScan
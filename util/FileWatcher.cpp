@@ -0,0 +1,98 @@
+#include "FileWatcher.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Util {
+
+#ifdef __linux__
+
+// How long to wait for the rest of a burst of events before reporting it.
+static constexpr int SettleTimeMs = 20;
+
+FileWatcher::FileWatcher(const std::string& path) {
+    m_fd = inotify_init1(IN_CLOEXEC);
+
+    if (m_fd >= 0 && !add(path)) {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool FileWatcher::add(const std::string& path) {
+    if (m_fd < 0) {
+        return false;
+    }
+    size_t slashPos = path.find_last_of('/');
+    std::string dirName = slashPos == std::string::npos ? "." : path.substr(0, slashPos + 1);
+    std::string fileName = slashPos == std::string::npos ? path : path.substr(slashPos + 1);
+
+    // Watching a directory again gives back the watch it already has.
+    int watchId = inotify_add_watch(m_fd, dirName.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+
+    if (watchId < 0) {
+        return false;
+    }
+    m_files.emplace(watchId, std::move(fileName));
+
+    return true;
+}
+
+FileWatcher::~FileWatcher() {
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+bool FileWatcher::wait() {
+    if (m_fd < 0) {
+        return false;
+    }
+    alignas(inotify_event) char eventBuf[4096];
+    bool fileChanged = false;
+
+    while (true) {
+        if (fileChanged) {
+            pollfd pollFd{ m_fd, POLLIN, 0 };
+
+            if (poll(&pollFd, 1, SettleTimeMs) <= 0) {
+                return true;
+            }
+        }
+        ssize_t bytesRead = read(m_fd, eventBuf, sizeof(eventBuf));
+
+        if (bytesRead <= 0) {
+            return false;
+        }
+        for (ssize_t pos = 0; pos < bytesRead;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(eventBuf + pos);
+
+            if (event->len > 0 && m_files.count({ event->wd, event->name }) > 0) {
+                fileChanged = true;
+            }
+            pos += sizeof(inotify_event) + event->len;
+        }
+    }
+}
+
+#else
+
+FileWatcher::FileWatcher(const std::string&) {}
+
+FileWatcher::~FileWatcher() {}
+
+bool FileWatcher::add(const std::string&) {
+    return false;
+}
+
+bool FileWatcher::wait() {
+    return false;
+}
+
+#endif
+
+} // namespace Util
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <utility>
+
+namespace Util {
+
+// Waits for any of a set of files to be written. Editors often save by
+// writing a new file and renaming it over the old one, so the directory
+// holding each file is watched rather than the file itself. Only supported
+// on Linux.
+class FileWatcher {
+public:
+    FileWatcher(const std::string& path);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher& other) = delete;
+    FileWatcher& operator = (const FileWatcher& other) = delete;
+
+    bool isOpen() const {
+        return m_fd >= 0;
+    }
+    explicit operator bool () const {
+        return isOpen();
+    }
+
+    // Watches another file as well. Returns false on failure.
+    bool add(const std::string& path);
+
+    // Blocks until a file has been written or replaced. A burst of events
+    // from one save is reported once. Returns false on failure.
+    bool wait();
+
+private:
+    int m_fd = -1;
+
+    // The watch on each file's directory, and the file's name within it.
+    std::set<std::pair<int, std::string>> m_files;
+};
+
+} // namespace Util
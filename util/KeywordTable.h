@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <util/StringView.h>
+
+namespace Util {
+
+namespace Internals {
+
+// Keywords are packed into a single 64-bit integer, one byte per character,
+// so that comparing a candidate against a table entry is one integer
+// comparison. Words longer than this can never be keywords.
+constexpr size_t MaxKeywordLength = 8;
+
+constexpr uint64_t PackKeyword(StringView word) {
+    uint64_t packed = 0;
+
+    for (size_t i = 0; i < word.size(); ++i) {
+        packed |= static_cast<uint64_t>(static_cast<uint8_t>(word[i])) << (8 * i);
+    }
+    return packed;
+}
+
+// Converts every ASCII lowercase letter among the eight packed bytes to
+// uppercase at once. Adding to the low seven bits of each byte sets its high
+// bit when the byte is at least 'a' (or above 'z'); the two sums differ only
+// for bytes in 'a'..'z'. Bytes with their own high bit set are left alone.
+constexpr uint64_t FoldKeywordCase(uint64_t packed) {
+    constexpr uint64_t Ones = 0x0101010101010101ULL;
+    constexpr uint64_t HighBits = Ones * 0x80;
+    constexpr uint64_t LowBits = Ones * 0x7F;
+
+    uint64_t lowSeven = packed & LowBits;
+    uint64_t aboveA = lowSeven + Ones * (0x80 - 'a');
+    uint64_t aboveZ = lowSeven + Ones * (0x80 - 'z' - 1);
+    uint64_t isLower = (aboveA ^ aboveZ) & ~packed & HighBits;
+
+    return packed ^ (isLower >> 2);
+}
+
+constexpr size_t KeywordTableSize(size_t numEntries) {
+    size_t tableSize = 1;
+
+    while (tableSize < numEntries * 4) {
+        tableSize *= 2;
+    }
+    return tableSize;
+}
+
+constexpr size_t Log2(size_t value) {
+    size_t result = 0;
+
+    while (value > 1) {
+        value /= 2;
+        ++result;
+    }
+    return result;
+}
+
+} // namespace Internals
+
+// A case-insensitive keyword lookup table built entirely at compile time.
+// The constructor searches for a multiplier that sends every keyword to a
+// distinct slot, so a lookup is a single hash and a single comparison.
+template <typename ValType, size_t NumEntries>
+class KeywordTable {
+    static constexpr size_t TableSize = Internals::KeywordTableSize(NumEntries);
+    static constexpr size_t HashShift = 64 - Internals::Log2(TableSize);
+
+public:
+    struct Entry {
+        StringView name;
+        ValType value;
+    };
+
+    constexpr KeywordTable(const Entry (&entries)[NumEntries]) {
+        uint64_t candidate = 0x9E3779B97F4A7C15ULL;
+
+        for (size_t attempt = 0; attempt < MaxAttempts; ++attempt) {
+            // Multipliers must be odd to keep every key bit significant.
+            m_multiplier = candidate | 1;
+
+            if (tryPopulate(entries)) {
+                return;
+            }
+            candidate = candidate * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        throw std::logic_error("Unable to find a perfect hash for the keywords.");
+    }
+
+    const ValType* find(StringView word) const {
+        if (word.size() == 0 || word.size() > Internals::MaxKeywordLength) {
+            return nullptr;
+        }
+        uint64_t key = Internals::FoldKeywordCase(Internals::PackKeyword(word));
+        size_t slot = slotOf(key);
+
+        return m_keys[slot] == key ? &m_values[slot] : nullptr;
+    }
+
+private:
+    static constexpr size_t MaxAttempts = 4096;
+
+    constexpr size_t slotOf(uint64_t key) const {
+        return static_cast<size_t>((key * m_multiplier) >> HashShift);
+    }
+
+    constexpr bool tryPopulate(const Entry (&entries)[NumEntries]) {
+        for (size_t i = 0; i < TableSize; ++i) {
+            m_keys[i] = 0;
+            m_values[i] = ValType{};
+        }
+        for (size_t i = 0; i < NumEntries; ++i) {
+            const StringView& name = entries[i].name;
+
+            if (name.size() == 0 || name.size() > Internals::MaxKeywordLength) {
+                throw std::logic_error("Keyword length is out of range.");
+            }
+            uint64_t key = Internals::FoldKeywordCase(Internals::PackKeyword(name));
+            size_t slot = slotOf(key);
+
+            if (m_keys[slot] == key) {
+                throw std::logic_error("Duplicate keyword.");
+            }
+            if (m_keys[slot] != 0) {
+                return false;
+            }
+            m_keys[slot] = key;
+            m_values[slot] = entries[i].value;
+        }
+        return true;
+    }
+
+    uint64_t m_multiplier = 0;
+    std::array<uint64_t, TableSize> m_keys{};
+    std::array<ValType, TableSize> m_values{};
+};
+
+} // namespace Util
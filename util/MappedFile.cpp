@@ -0,0 +1,67 @@
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+
+namespace Util {
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        return;
+    }
+    struct stat fileStat;
+
+    if (::fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode)) {
+        m_size = static_cast<size_t>(fileStat.st_size);
+
+        if (m_size == 0) {
+            m_isOpen = true;
+        } else {
+            void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data != MAP_FAILED) {
+                m_data = data;
+                m_isOpen = true;
+            } else {
+                m_size = 0;
+            }
+        }
+    }
+    // The mapping stays valid once the descriptor is closed.
+    ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) :
+  m_data{ std::exchange(other.m_data, nullptr) },
+  m_size{ std::exchange(other.m_size, 0) },
+  m_isOpen{ std::exchange(other.m_isOpen, false) }
+{}
+
+MappedFile& MappedFile::operator = (MappedFile&& other) {
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_isOpen = std::exchange(other.m_isOpen, false);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close() {
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_isOpen = false;
+}
+
+} // namespace Util
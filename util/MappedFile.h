@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "StringView.h"
+
+namespace Util {
+
+// A file mapped read-only into memory, unmapped when the object goes away.
+class MappedFile {
+public:
+    MappedFile() {}
+
+    // Maps the file at path. The result is closed on failure.
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(MappedFile&& other);
+    MappedFile& operator = (MappedFile&& other);
+    ~MappedFile();
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator = (const MappedFile& other) = delete;
+
+    bool isOpen() const {
+        return m_isOpen;
+    }
+    explicit operator bool () const {
+        return isOpen();
+    }
+
+    // The contents of the file. An empty file is open but maps nothing.
+    StringView text() const {
+        return StringView{ static_cast<const char*>(m_data), m_size };
+    }
+
+    void close();
+
+private:
+    void* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_isOpen = false;
+};
+
+} // namespace Util
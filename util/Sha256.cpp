@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <cstring>
+#include "Sha256.h"
+
+namespace Util {
+
+static constexpr uint32_t RoundConstants[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+static constexpr uint32_t RotateRight(uint32_t value, int count) {
+    return (value >> count) | (value << (32 - count));
+}
+
+Sha256::Sha256() :
+  m_state{ 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+           0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 }
+{}
+
+void Sha256::update(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    m_totalSize += size;
+
+    if (m_bufferSize > 0) {
+        size_t numCopied = std::min(size, m_buffer.size() - m_bufferSize);
+
+        std::memcpy(m_buffer.data() + m_bufferSize, bytes, numCopied);
+        m_bufferSize += numCopied;
+        bytes += numCopied;
+        size -= numCopied;
+
+        if (m_bufferSize < m_buffer.size()) {
+            return;
+        }
+        processBlock(m_buffer.data());
+        m_bufferSize = 0;
+    }
+    for (; size >= m_buffer.size(); bytes += m_buffer.size(), size -= m_buffer.size()) {
+        processBlock(bytes);
+    }
+    std::memcpy(m_buffer.data(), bytes, size);
+    m_bufferSize = size;
+}
+
+Sha256::Digest Sha256::finish() {
+    uint64_t numBits = m_totalSize * 8;
+    uint8_t padding[72] = { 0x80 };
+    size_t paddingSize = (m_bufferSize < 56 ? 56 : 120) - m_bufferSize;
+
+    for (int i = 0; i < 8; ++i) {
+        padding[paddingSize + i] = static_cast<uint8_t>(numBits >> (56 - 8 * i));
+    }
+    update(padding, paddingSize + 8);
+
+    Digest digest;
+
+    for (size_t i = 0; i < m_state.size(); ++i) {
+        for (int j = 0; j < 4; ++j) {
+            digest[4 * i + j] = static_cast<uint8_t>(m_state[i] >> (24 - 8 * j));
+        }
+    }
+    return digest;
+}
+
+std::string Sha256::toHex(const Digest& digest) {
+    static constexpr char HexDigits[] = "0123456789abcdef";
+    std::string hexStr;
+
+    for (uint8_t byte : digest) {
+        hexStr += HexDigits[byte >> 4];
+        hexStr += HexDigits[byte & 0xF];
+    }
+    return hexStr;
+}
+
+void Sha256::processBlock(const uint8_t* block) {
+    uint32_t schedule[64];
+
+    for (int i = 0; i < 16; ++i) {
+        schedule[i] = (uint32_t{ block[4 * i] } << 24) | (uint32_t{ block[4 * i + 1] } << 16) |
+                      (uint32_t{ block[4 * i + 2] } << 8) | uint32_t{ block[4 * i + 3] };
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = RotateRight(schedule[i - 15], 7) ^ RotateRight(schedule[i - 15], 18) ^
+                      (schedule[i - 15] >> 3);
+        uint32_t s1 = RotateRight(schedule[i - 2], 17) ^ RotateRight(schedule[i - 2], 19) ^
+                      (schedule[i - 2] >> 10);
+
+        schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+    }
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+    uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+        uint32_t choice = (e & f) ^ (~e & g);
+        uint32_t temp1 = h + s1 + choice + RoundConstants[i] + schedule[i];
+        uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+        uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+    m_state[5] += f;
+    m_state[6] += g;
+    m_state[7] += h;
+}
+
+} // namespace Util
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Util {
+
+// Incremental SHA-256. Used where a digest has to stand in for the data it
+// was computed from, such as the keys of the assembly cache.
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256();
+
+    void update(const void* data, size_t size);
+
+    // Returns the digest of everything passed to update. The object must
+    // not be used again afterwards.
+    Digest finish();
+
+    static std::string toHex(const Digest& digest);
+
+private:
+    void processBlock(const uint8_t* block);
+
+    std::array<uint32_t, 8> m_state;
+    std::array<uint8_t, 64> m_buffer;
+    size_t m_bufferSize = 0;
+    uint64_t m_totalSize = 0;
+};
+
+} // namespace Util
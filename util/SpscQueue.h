@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Util {
+
+// A bounded, lock-free queue between exactly one producer thread and one
+// consumer thread. Either side may close it: the consumer then drains
+// whatever is left, and a producer pushing into a closed queue is told to
+// stop. The blocking calls yield while they wait.
+template <typename T>
+class SpscQueue {
+public:
+    // The capacity is rounded up to one less than a power of two, since one
+    // slot always stays empty to tell a full queue from an empty one.
+    explicit SpscQueue(size_t capacity) :
+      m_slots(RoundUpPow2(capacity + 1)),
+      m_mask{ m_slots.size() - 1 }
+    {}
+
+    SpscQueue(const SpscQueue& other) = delete;
+    SpscQueue& operator = (const SpscQueue& other) = delete;
+
+    size_t capacity() const {
+        return m_mask;
+    }
+
+    // Producer side. Moves from value only if it was queued.
+    bool tryPush(T& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t nextTail = (tail + 1) & m_mask;
+
+        if (nextTail == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        m_slots[tail] = std::move(value);
+        m_tail.store(nextTail, std::memory_order_release);
+
+        return true;
+    }
+
+    // Returns false, without queueing value, once the queue is closed.
+    bool push(T value) {
+        while (!isClosed()) {
+            if (tryPush(value)) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    // Consumer side.
+    bool tryPop(T& value) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(m_slots[head]);
+        m_head.store((head + 1) & m_mask, std::memory_order_release);
+
+        return true;
+    }
+
+    // Returns false once the queue is closed and empty.
+    bool pop(T& value) {
+        while (!tryPop(value)) {
+            if (isClosed()) {
+                // Whatever was pushed before the close is still delivered.
+                return tryPop(value);
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    void close() {
+        m_isClosed.store(true, std::memory_order_release);
+    }
+
+    bool isClosed() const {
+        return m_isClosed.load(std::memory_order_acquire);
+    }
+
+private:
+    static size_t RoundUpPow2(size_t value) {
+        size_t result = 2;
+
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::vector<T> m_slots;
+    size_t m_mask;
+
+    // Kept on separate cache lines so that the two threads do not contend
+    // for the same line on every operation.
+    alignas(64) std::atomic<size_t> m_head{ 0 };
+    alignas(64) std::atomic<size_t> m_tail{ 0 };
+    alignas(64) std::atomic<bool> m_isClosed{ false };
+};
+
+} // namespace Util
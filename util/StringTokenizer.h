@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <string>
 #include "CharClass.h"
+#include "CharScan.h"
 #include "StringView.h"
 
 namespace Util {
@@ -113,24 +114,22 @@ private:
         return (numChars <= rangeLen) ? start + numChars : end;
     }
     static StrIter fetchUntil(const StrIter& start, const StrIter& end, const CharClass& blacklist) {
-        assert(end >= start);
-
-        StrIter curr = start;
-
-        while (curr != end && !blacklist(*curr)) {
-            ++curr;
-        }
-        return curr;
+        return StringTokenizer::fetchFirst(start, end, blacklist, true);
     }
     static StrIter fetchUntilNot(const StrIter& start, const StrIter& end, const CharClass& whitelist) {
+        return StringTokenizer::fetchFirst(start, end, whitelist, false);
+    }
+    static StrIter fetchFirst(const StrIter& start, const StrIter& end,
+                              const CharClass& charClass, bool stopValue)
+    {
         assert(end >= start);
 
-        StrIter curr = start;
+        StringView range{ start, end };
+        const char* rangeEnd = range.data() + range.size();
+        const char* found = CharScan::FindFirst(range.data(), rangeEnd,
+                                                charClass, stopValue);
 
-        while (curr != end && whitelist(*curr)) {
-            ++curr;
-        }
-        return curr;
+        return start + (found - range.data());
     }
 
 private:
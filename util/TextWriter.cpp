@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include "TextWriter.h"
+
+namespace Util {
+
+TextWriter::TextWriter(const char* fileName) :
+  m_file{ std::fopen(fileName, "w") },
+  m_buffer{ new char[BufferSize] }
+{}
+
+TextWriter::TextWriter(std::FILE* file) :
+  m_file{ file },
+  m_ownsFile{ false },
+  m_buffer{ new char[BufferSize] }
+{}
+
+TextWriter::~TextWriter() {
+    close();
+}
+
+// Returns room for size characters at the end of the buffer, which must be
+// no larger than BufferSize.
+char* TextWriter::reserve(size_t size) {
+    if (m_size + size > BufferSize) {
+        flush();
+    }
+    char* dest = m_buffer.get() + m_size;
+    m_size += size;
+
+    return dest;
+}
+
+void TextWriter::flush() {
+    if (m_file != nullptr && m_size > 0 &&
+        std::fwrite(m_buffer.get(), 1, m_size, m_file) != m_size)
+    {
+        m_failed = true;
+    }
+    m_size = 0;
+}
+
+void TextWriter::put(char ch) {
+    *reserve(1) = ch;
+}
+
+void TextWriter::put(StringView str) {
+    if (str.size() > BufferSize) {
+        flush();
+
+        if (m_file != nullptr && std::fwrite(str.data(), 1, str.size(), m_file) != str.size()) {
+            m_failed = true;
+        }
+        return;
+    }
+    std::memcpy(reserve(str.size()), str.data(), str.size());
+}
+
+void TextWriter::putHex(uint32_t value, size_t width) {
+    char digits[8];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, 16);
+    size_t numDigits = static_cast<size_t>(result.ptr - digits);
+    size_t numZeros = width > numDigits ? width - numDigits : 0;
+
+    char* dest = reserve(numZeros + numDigits);
+
+    std::fill_n(dest, numZeros, '0');
+    std::memcpy(dest + numZeros, digits, numDigits);
+}
+
+void TextWriter::putDecimal(int32_t value) {
+    char digits[12];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    size_t numDigits = static_cast<size_t>(result.ptr - digits);
+
+    std::memcpy(reserve(numDigits), digits, numDigits);
+}
+
+bool TextWriter::close() {
+    if (m_file == nullptr) {
+        return false;
+    }
+    flush();
+
+    if ((m_ownsFile ? std::fclose(m_file) : std::fflush(m_file)) != 0) {
+        m_failed = true;
+    }
+    m_file = nullptr;
+
+    return !m_failed;
+}
+
+} // namespace Util
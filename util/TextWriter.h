@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include "StringView.h"
+
+namespace Util {
+
+// Writes text to a file through a large buffer of its own. Numbers are
+// formatted with std::to_chars straight into the buffer, so nothing goes
+// through locales or stream state, and the file only sees whole buffers.
+class TextWriter {
+public:
+    static constexpr size_t BufferSize = 1 << 16;
+
+    explicit TextWriter(const char* fileName);
+
+    // Writes to a file that is already open, such as stdout. It is flushed
+    // by close() but left open.
+    explicit TextWriter(std::FILE* file);
+    ~TextWriter();
+
+    TextWriter(const TextWriter& other) = delete;
+    TextWriter& operator = (const TextWriter& other) = delete;
+
+    // Whether the file is open and everything so far was written.
+    explicit operator bool () const {
+        return m_file != nullptr && !m_failed;
+    }
+
+    void put(char ch);
+    void put(StringView str);
+
+    // Writes value in lowercase hexadecimal, padded with zeros to width
+    // digits.
+    void putHex(uint32_t value, size_t width);
+
+    void putDecimal(int32_t value);
+
+    // Writes out whatever is buffered and closes the file. Returns false if
+    // any of it could not be written.
+    bool close();
+
+private:
+    char* reserve(size_t size);
+    void flush();
+
+    std::FILE* m_file = nullptr;
+    bool m_ownsFile = true;
+    std::unique_ptr<char[]> m_buffer;
+    size_t m_size = 0;
+    bool m_failed = false;
+};
+
+} // namespace Util
@@ -0,0 +1,113 @@
+#include <utility>
+#include "ThreadPool.h"
+
+namespace Util {
+
+ThreadPool::ThreadPool(size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = 1;
+    }
+    for (size_t i = 0; i < numThreads; ++i) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < numThreads; ++i) {
+        m_threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_isStopping = true;
+    }
+    m_jobsQueued.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Job job) {
+    size_t queueIndex = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+
+        queueIndex = m_nextQueue;
+        m_nextQueue = (m_nextQueue + 1) % m_queues.size();
+
+        ++m_numQueued;
+        ++m_numPending;
+    }
+    {
+        WorkQueue& queue = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        queue.jobs.push_back(std::move(job));
+    }
+    m_jobsQueued.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(m_stateMutex);
+
+    m_jobsDone.wait(lock, [this]() { return m_numPending == 0; });
+}
+
+bool ThreadPool::takeJob(size_t workerIndex, Job& job) {
+    {
+        WorkQueue& ownQueue = *m_queues[workerIndex];
+        std::lock_guard<std::mutex> lock(ownQueue.mutex);
+
+        if (!ownQueue.jobs.empty()) {
+            job = std::move(ownQueue.jobs.back());
+            ownQueue.jobs.pop_back();
+
+            return true;
+        }
+    }
+    for (size_t i = 1; i < m_queues.size(); ++i) {
+        WorkQueue& victim = *m_queues[(workerIndex + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t workerIndex) {
+    for (;;) {
+        Job job;
+
+        if (takeJob(workerIndex, job)) {
+            {
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                --m_numQueued;
+            }
+            job();
+
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+
+            if (--m_numPending == 0) {
+                m_jobsDone.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+
+        // A job can be counted as queued for a moment before it is pushed,
+        // in which case this loops around and tries again.
+        m_jobsQueued.wait(lock, [this]() { return m_isStopping || m_numQueued > 0; });
+
+        if (m_isStopping && m_numQueued == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace Util
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Util {
+
+// A fixed set of worker threads, each with a queue of its own. Workers take
+// jobs from the back of their own queue and, once it runs dry, steal from
+// the front of the others'.
+class ThreadPool {
+public:
+    using Job = std::function<void()>;
+
+    explicit ThreadPool(size_t numThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator = (const ThreadPool& other) = delete;
+
+    size_t size() const {
+        return m_threads.size();
+    }
+
+    void submit(Job job);
+
+    // Blocks until every submitted job has finished running.
+    void wait();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool takeJob(size_t workerIndex, Job& job);
+    void workerLoop(size_t workerIndex);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_stateMutex;
+    std::condition_variable m_jobsQueued;
+    std::condition_variable m_jobsDone;
+    size_t m_numQueued = 0;
+    size_t m_numPending = 0;
+    size_t m_nextQueue = 0;
+    bool m_isStopping = false;
+};
+
+} // namespace Util
@@ -0,0 +1,137 @@
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "UnixSocket.h"
+
+namespace Util {
+
+static bool MakeAddress(const std::string& path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    return true;
+}
+
+UnixSocket::UnixSocket(UnixSocket&& other) :
+  m_fd{ std::exchange(other.m_fd, -1) }
+{}
+
+UnixSocket& UnixSocket::operator = (UnixSocket&& other) {
+    if (this != &other) {
+        close();
+        m_fd = std::exchange(other.m_fd, -1);
+    }
+    return *this;
+}
+
+UnixSocket::~UnixSocket() {
+    close();
+}
+
+UnixSocket UnixSocket::connect(const std::string& path) {
+    sockaddr_un addr;
+
+    if (!MakeAddress(path, addr)) {
+        return UnixSocket{};
+    }
+    UnixSocket sock{ ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0) };
+
+    if (sock && ::connect(sock.m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        sock.close();
+    }
+    return sock;
+}
+
+UnixSocket UnixSocket::listen(const std::string& path) {
+    sockaddr_un addr;
+
+    if (!MakeAddress(path, addr)) {
+        return UnixSocket{};
+    }
+    struct stat pathStat;
+
+    if (::lstat(path.c_str(), &pathStat) == 0 && S_ISSOCK(pathStat.st_mode)) {
+        ::unlink(path.c_str());
+    }
+    UnixSocket sock{ ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0) };
+
+    if (sock && (::bind(sock.m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+                 ::listen(sock.m_fd, SOMAXCONN) != 0))
+    {
+        sock.close();
+    }
+    return sock;
+}
+
+UnixSocket UnixSocket::accept() const {
+    int fd = -1;
+
+    do {
+        fd = ::accept4(m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+
+    return UnixSocket{ fd };
+}
+
+bool UnixSocket::setTimeout(std::chrono::milliseconds timeout) {
+    timeval tv;
+    tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    tv.tv_usec = static_cast<suseconds_t>(timeout.count() % 1000 * 1000);
+
+    return ::setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0 &&
+           ::setsockopt(m_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) == 0;
+}
+
+bool UnixSocket::readAll(void* data, size_t size) {
+    auto* bytes = static_cast<char*>(data);
+
+    while (size > 0) {
+        ssize_t numRead = ::recv(m_fd, bytes, size, 0);
+
+        if (numRead < 0 && errno == EINTR) continue;
+
+        if (numRead <= 0) {
+            return false;
+        }
+        bytes += numRead;
+        size -= static_cast<size_t>(numRead);
+    }
+    return true;
+}
+
+bool UnixSocket::writeAll(const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+
+    while (size > 0) {
+        // A peer that has gone away should fail the write, not raise SIGPIPE.
+        ssize_t numWritten = ::send(m_fd, bytes, size, MSG_NOSIGNAL);
+
+        if (numWritten < 0 && errno == EINTR) continue;
+
+        if (numWritten <= 0) {
+            return false;
+        }
+        bytes += numWritten;
+        size -= static_cast<size_t>(numWritten);
+    }
+    return true;
+}
+
+void UnixSocket::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+} // namespace Util
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace Util {
+
+// A stream socket in the Unix domain, closed when the object goes away.
+class UnixSocket {
+public:
+    UnixSocket() {}
+
+    explicit UnixSocket(int fd) :
+      m_fd{ fd }
+    {}
+
+    UnixSocket(UnixSocket&& other);
+    UnixSocket& operator = (UnixSocket&& other);
+    ~UnixSocket();
+
+    UnixSocket(const UnixSocket& other) = delete;
+    UnixSocket& operator = (const UnixSocket& other) = delete;
+
+    // Connects to the socket bound to path. The result is closed on failure.
+    static UnixSocket connect(const std::string& path);
+
+    // Binds a socket to path and listens on it. A socket already at path is
+    // assumed to be left over from an earlier server and is replaced.
+    static UnixSocket listen(const std::string& path);
+
+    // Waits for a client to connect to a listening socket.
+    UnixSocket accept() const;
+
+    bool isOpen() const {
+        return m_fd >= 0;
+    }
+    explicit operator bool () const {
+        return isOpen();
+    }
+
+    // Makes a read or write that waits longer than timeout for the peer
+    // fail. Returns false if the socket refuses.
+    bool setTimeout(std::chrono::milliseconds timeout);
+
+    // Transfer exactly size bytes, returning false if the peer goes away,
+    // stalls past the timeout, or something else goes wrong first.
+    bool readAll(void* data, size_t size);
+    bool writeAll(const void* data, size_t size);
+
+    void close();
+
+private:
+    int m_fd = -1;
+};
+
+} // namespace Util